@@ -2,16 +2,16 @@
 #define APP_H
 
 #include "AppContext.h"
+#include "FrameProfiler.h"
 #include "Helpers.h"
 #include "Scene.h"
+#include "Trace.h"
+#include "Transition32.h"
 #include <memory>
+#include <new>
 #include <utility>
 
-#ifdef GRID_EMULATION
-#include "SDLMatrix32.h"
-#else
-#include "RGBMatrix32.h"
-#endif
+#include "GridMatrix.h"
 
 #include "SceneBus.h"
 #include "SnakeScene.h"
@@ -24,7 +24,7 @@
 #include "StartScene.h"
 #include "SaveScoreScene.h"
 
-// App manages the current scene; only holds Matrix32&
+// App manages the current scene; only holds GridMatrix&
 class App
 {
     AppContext ctx;
@@ -41,12 +41,128 @@ class App
     bool prevLeft = false;
     bool prevRight = false;
     bool prevPress = false;
+    // Menu state last drawn; the menu is only redrawn when it changes
+    static constexpr uint8_t kPauseMenuStale = UINT8_MAX;
+    uint8_t pauseMenuDrawn_ = kPauseMenuStale;
     static constexpr millis_t PAUSE_TRIGGER_MS = 5000;
     // Basic nav: X left/right to change selection, button to activate
     // Simple hysteresis with thresholds
     static constexpr float HYSTERESIS_THRESHOLD = 0.45f;
     static constexpr millis_t SELECT_WAIT = 500; // wait after select for drama
 
+    // --- Scene transitions ---
+    Transition32::Kind transitionKind_ = Transition32::Kind::Cut;
+    millis_t transitionMs_ = 0;
+    std::unique_ptr<Transition32> transition_; // only allocated while one runs
+    bool transitionPending_ = false; // transition_ waits for the new scene's first frame
+    uint16_t transitionSteps_ = 0;
+    uint32_t transitionTotalUs_ = 0;
+    uint32_t transitionMaxUs_ = 0;
+
+    // Write the next transition frame; on the last one, log the step cost and
+    // hand the screen to the scene with a fresh scene clock
+    void stepTransition()
+    {
+        GRID_TRACE_SCOPE("transition", "app");
+        const uint32_t t0 = ctx.time.nowUs();
+        const bool running = transition_->step(ctx.gfx, ctx.time.nowMs());
+        const uint32_t us = ctx.time.nowUs() - t0;
+        ++transitionSteps_;
+        transitionTotalUs_ += us;
+        if (us > transitionMaxUs_)
+            transitionMaxUs_ = us;
+        if (running)
+            return;
+        ctx.logger.logf(LogLevel::Debug, "Transition: %u steps, avg %lu us, max %lu us",
+                        unsigned(transitionSteps_), static_cast<unsigned long>(transitionTotalUs_ / transitionSteps_),
+                        static_cast<unsigned long>(transitionMaxUs_));
+        transition_.reset();
+        ctx.time.resetSceneClock();
+    }
+
+    // The incoming scene has drawn its first frame behind held presents:
+    // capture it and start playing the transition, whose first frame replaces
+    // it before the show. A scene that presented on its own meanwhile (show()
+    // ends the hold) is already on screen, so that switch becomes a cut.
+    void startTransition()
+    {
+        transitionPending_ = false;
+        if (!ctx.gfx.presentsHeld())
+        {
+            transition_.reset();
+            return;
+        }
+        transition_->to().capture(ctx.gfx);
+        ctx.gfx.holdPresents(false);
+        transition_->start(transitionKind_, transitionMs_, ctx.time.nowMs());
+        transitionSteps_ = 0;
+        transitionTotalUs_ = 0;
+        transitionMaxUs_ = 0;
+        stepTransition();
+    }
+
+    // --- Post-processing cost, logged with the diagnostics ---
+    uint16_t postFXFrames_ = 0;
+    uint32_t postFXTotalUs_ = 0;
+    uint32_t postFXMaxUs_ = 0;
+    uint32_t postFXFrameUs_ = 0; // this frame so far (decays of every step, then filters)
+    bool postFXRan_ = false;
+    bool sceneStepped_ = false; // the scene's loop() ran since the last render()
+    uint8_t sceneSerial_ = 0;   // bumped by setScene(), to spot a switch inside loop()
+
+    // --- Per-phase timings, reset per scene and logged with the diagnostics ---
+    FrameProfiler profiler_{ctx.time};
+
+    // Scene step preceded by the decay pass, which fades the previous frame
+    // before the scene draws over it
+    void loopScene()
+    {
+        const PostFX32 *fx = current->postFX();
+        if (fx && fx->decays())
+        {
+            postFXRan_ = true;
+            const uint32_t t0 = ctx.time.nowUs();
+            fx->decay(ctx.gfx);
+            postFXFrameUs_ += ctx.time.nowUs() - t0;
+        }
+        const uint8_t serial = sceneSerial_;
+        {
+            FrameProfiler::Scope timed(profiler_, FrameProfiler::Loop);
+            GRID_TRACE_SCOPE(current->label(), "scene");
+            current->loop(ctx);
+        }
+        // loop() may have switched scenes; the new one has not stepped yet
+        sceneStepped_ = serial == sceneSerial_;
+    }
+
+    // Scene draw phase: in-between drawing, then filters on the finished frame
+    // (once per presented frame, however many steps led to it)
+    void renderScene()
+    {
+        GRID_TRACE_SCOPE("renderScene", "app");
+        current->render(ctx);
+        const PostFX32 *fx = sceneStepped_ ? current->postFX() : nullptr;
+        if (fx && fx->filters())
+        {
+            postFXRan_ = true;
+            const uint32_t t0 = ctx.time.nowUs();
+            fx->filter(ctx.gfx);
+            postFXFrameUs_ += ctx.time.nowUs() - t0;
+        }
+    }
+
+    void recordPostFX()
+    {
+        if (!postFXRan_)
+            return;
+        ++postFXFrames_;
+        postFXTotalUs_ += postFXFrameUs_;
+        if (postFXFrameUs_ > postFXMaxUs_)
+            postFXMaxUs_ = postFXFrameUs_;
+        postFXFrameUs_ = 0;
+        postFXRan_ = false;
+    }
+
     bool checkCurrentSceneCanPause() const
     {
         bool isStart = (current && current->kind() == Scene::SceneKind::Start);
@@ -137,7 +253,13 @@ class App
         if ((left && !prevLeft) || (right && !prevRight))
             selectQuit_ = !selectQuit_;
 
-        drawPauseMenu(selectQuit_, left, right, press && !prevPress);
+        const bool pressed = press && !prevPress;
+        const uint8_t menuState = uint8_t(selectQuit_) | uint8_t(left) << 1 | uint8_t(right) << 2 | uint8_t(pressed) << 3;
+        if (menuState != pauseMenuDrawn_)
+        {
+            drawPauseMenu(selectQuit_, left, right, pressed);
+            pauseMenuDrawn_ = menuState;
+        }
 
         if (press && !prevPress && ctx.bus)
         {
@@ -152,6 +274,8 @@ class App
                 else
                     this->setScene<MenuScene>();
             }
+            else
+                current->resume(ctx);
             paused_ = false;
         }
 
@@ -166,6 +290,7 @@ class App
         selectQuit_ = false;
         pausePrevPressed_ = false;
         pauseArmed_ = false;
+        pauseMenuDrawn_ = kPauseMenuStale;
         // avoid errant input from previous Scene
         prevPress = true;
         prevLeft = true;
@@ -173,7 +298,7 @@ class App
     }
 
 public:
-    explicit App(Matrix32 &gfx, Timing &time, Input &input, ILogger &logger, IStorage &storage) : ctx{gfx, time, input, logger, storage}
+    explicit App(GridMatrix &gfx, Timing &time, Input &input, ILogger &logger, IStorage &storage) : ctx{gfx, time, input, logger, storage}
     {
         ctx.bus = &bus;
         // Bind routes. Lambdas capture this App and call setScene.
@@ -198,57 +323,150 @@ public:
         };
     }
 
+    static constexpr millis_t kDefaultTransitionMs = 400;
+
+    // Animate later scene switches from the outgoing frame to the incoming
+    // scene's first frame (Kind::Cut switches instantly, the default)
+    void setTransition(Transition32::Kind kind, millis_t durationMs = kDefaultTransitionMs)
+    {
+        transitionKind_ = kind;
+        transitionMs_ = durationMs;
+    }
+    bool inTransition() const { return bool(transition_); }
+
     // Replace the current scene with a newly constructed SceneT.
     // - Destroys the old scene, creates SceneT(args...), then calls setup(gfx).
+    // - With a transition set, the old frame is captured first and presents
+    //   are held through setup() and the new scene's first step; render()
+    //   then captures that frame and plays the transition before the scene
+    //   carries on. Falls back to a cut if the ~4.2 KB of canvases cannot be
+    //   allocated or the scene presents by itself (see startTransition()).
     // - Perfect-forwards args to SceneT's ctor (no unnecessary copies).
     // - Fails to compile if SceneT is not compatible with Scene or ctor args.
     template <typename SceneT, typename... Args>
     void setScene(Args &&...args)
     {
         static_assert(std::is_base_of<Scene, SceneT>::value, "SceneT must derive from Scene");
-        current.reset(new SceneT(std::forward<Args>(args)...));
+        GRID_TRACE_SCOPE("setScene", "app");
+        std::unique_ptr<Transition32> transition;
+        if (transitionPending_ && ctx.gfx.presentsHeld())
+            transition = std::move(transition_); // the screen still shows its from() frame
+        else if (current && transitionKind_ != Transition32::Kind::Cut)
+        {
+            transition.reset(new (std::nothrow) Transition32());
+            if (transition)
+                transition->from().capture(ctx.gfx);
+        }
+        Scene *next = new SceneT(std::forward<Args>(args)...);
+#if !defined(GRID_EMULATION)
+        // Peak RAM: old and new scene plus both canvases
+        if (transition)
+            ctx.logger.logf(LogLevel::Debug, "Transition canvases: %u bytes, free RAM: %d", unsigned(sizeof(Transition32)),
+                            Helpers::freeRam());
+#endif
+        current.reset(next);
+        ++sceneSerial_;
         ctx.logger.logf(LogLevel::Debug, "Started %s Scene.", current->label());
+        profiler_.reset(current->label());
         // apply preferred timing
         auto prefs = current->timingPrefs();
         ctx.time.applyPreference(prefs);
         ctx.time.resetSceneClock();
-        // immediate only during setup (works on SDLMatrix32, no-op on Arduino)
+        // immediate only during setup; presents are coalesced and flushed on the way out
+        ctx.gfx.holdPresents(bool(transition));
         ctx.gfx.setImmediate(true);
         ctx.gfx.clear();
         current->setup(ctx);
         ctx.gfx.setImmediate(false);
+        transitionPending_ = bool(transition);
+        transition_ = std::move(transition); // a cut also ends any transition in flight
     }
 
-    // Call the current scene's loop(ctx).
-    // dt is in milliseconds.
-    void loopOnce()
+    // Update phase: sample input and advance the transition, pause menu or
+    // scene by one fixed step. Nothing is presented until render().
+    void update()
     {
-        ctx.input.sample();
-        if (paused_)
+        GRID_TRACE_SCOPE("update", "app");
+        {
+            FrameProfiler::Scope timed(profiler_, FrameProfiler::Input);
+            GRID_TRACE_SCOPE("input", "app");
+            ctx.input.sample();
+        }
+        if (transitionPending_)
+            loopScene(); // the new scene's first frame, drawn behind held presents
+        else if (transition_)
+            stepTransition();
+        else if (paused_)
             handlePause();
         else
         {
             if (checkCurrentSceneCanPause() && checkPauseTrigger())
                 pause();
             else
-                current->loop(ctx);
+                loopScene();
+        }
+    }
+
+    // Draw phase: finish the frame and present it once. A caller that ran
+    // several update() steps to catch up renders only the last one.
+    void render()
+    {
+        GRID_TRACE_SCOPE("render", "app");
+        if (transitionPending_ && !sceneStepped_)
+            return; // a switch inside loop(): wait for the new scene's first step
+        if ((!transition_ || transitionPending_) && !paused_)
+            renderScene();
+        sceneStepped_ = false;
+        if (transitionPending_)
+            startTransition();
+        recordPostFX();
+        {
+            FrameProfiler::Scope timed(profiler_, FrameProfiler::Show);
+            GRID_TRACE_SCOPE("show", "app");
+            ctx.gfx.show();
         }
-        ctx.gfx.show();
+        profiler_.frameDone();
+    }
+
+    // Label of the running scene ("-" before the first setScene())
+    const char *sceneLabel() const { return current ? current->label() : "-"; }
+
+    // True when render() is worth calling between update() steps too
+    bool drawsBetweenSteps() const { return current && !transition_ && !paused_ && current->interpolates(); }
+
+    // One step and one frame: for callers that update once per frame
+    void loopOnce()
+    {
+        update();
+        render();
     }
 
     // Logs helpful diagnostics: FPS, plus calibration values
     void logDiagnostics()
     {
-        float fps = ctx.time.fps();
         InputState input = ctx.input.state();
-        // Log FPS
-        ctx.logger.logf(LogLevel::Debug, "FPS: %5.2f", fps);
-        ctx.logger.flush();
+        // Log FPS as measured from presented frames, against the scene's target
+        ctx.logger.logf(LogLevel::Debug, "FPS: %5.2f (target %5.2f)", profiler_.measuredFps(), ctx.time.targetHz());
+        {
+            FrameProfiler::Scope timed(profiler_, FrameProfiler::Flush);
+            ctx.logger.flush();
+        }
         // Log inputs
         ctx.logger.logf(LogLevel::Debug, "Raw X: %d Y: %d, Norm X: %5.3f Y: %5.3f, Pressed: %d",
                         input.x_adc, input.y_adc,
                         input.x, input.y,
                         input.pressed ? 1 : 0);
+        // Log post-processing cost since the last report
+        if (postFXFrames_)
+        {
+            ctx.logger.logf(LogLevel::Debug, "PostFX: %u frames, avg %lu us, max %lu us",
+                            unsigned(postFXFrames_), static_cast<unsigned long>(postFXTotalUs_ / postFXFrames_),
+                            static_cast<unsigned long>(postFXMaxUs_));
+            postFXFrames_ = 0;
+            postFXTotalUs_ = 0;
+            postFXMaxUs_ = 0;
+        }
+        profiler_.log(ctx.logger);
     }
 };
 
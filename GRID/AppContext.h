@@ -1,7 +1,7 @@
 #ifndef APP_CONTEXT_H
 #define APP_CONTEXT_H
 
-#include "Matrix32.h"
+#include "GridMatrix.h"
 #include "Timing.h"
 #include "Input.h"
 #include "Logging.h"
@@ -12,7 +12,7 @@ struct SceneBus;
 
 struct AppContext
 {
-    Matrix32 &gfx;     // reference to Matrix 32x32 graphics
+    GridMatrix &gfx;   // reference to Matrix 32x32 graphics (concrete backend)
     Timing &time;      // reference to timing interface
     Input &input;      // reference to input interface
     ILogger &logger;   // reference to logger interface
@@ -21,7 +21,7 @@ struct AppContext
     // Optional scene router; set by App. May be null in older code.
     SceneBus *bus = nullptr;
 
-    AppContext(Matrix32 &gfx,
+    AppContext(GridMatrix &gfx,
                Timing &time,
                Input &input,
                ILogger &logger,
@@ -27,7 +27,6 @@ public:
     // No cadence control; just reflect Arduino time
     millis_t nowMs() const override { return millis() - startMs_; }
     float dtMs() const override { return dtMs_; } // nominal
-    float fps() const override { return static_cast<float>(targetHz_); }
     double targetHz() const override { return targetHz_; }
 
     // When there is a preferred timing, apply it; otherwise use default
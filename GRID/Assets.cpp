@@ -0,0 +1,26 @@
+// Generated by assetpack (`make assets`) from assets/grid_logo.txt assets/qr.txt.
+// Edit the sources and regenerate instead of editing this file.
+
+#include "Assets.h"
+
+namespace Assets
+{
+static const uint8_t kGridLogoBits[40] = {
+    0xFC, 0xFC, 0x03, 0x03, 0xF3, 0xF3, 0xC3, 0xC3, 0x3C, 0x3C, 0x3F, 0x3F,
+    0xC3, 0xC3, 0x3F, 0x3F, 0x33, 0x33, 0xC3, 0xC3, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x3F, 0x3F, 0xC1, 0xC1, 0xC1, 0xC1,
+    0xC1, 0xC1, 0x3F, 0x3F};
+static const Color333 kGridLogoPalette[1] = {{0, 1, 0}};
+const Sprite32 kGridLogo = {8, 10, 1, 4, kGridLogoBits, kGridLogoPalette};
+
+static const uint8_t kQRCodeBits[79] = {
+    0x80, 0x86, 0x03, 0x7C, 0xF3, 0xF7, 0x89, 0x2E, 0x2E, 0x12, 0x7D, 0x52,
+    0x24, 0x5A, 0xB9, 0xC8, 0x77, 0x7D, 0x1F, 0xA0, 0xAA, 0x80, 0x7F, 0x69,
+    0xFF, 0xA4, 0x21, 0xFB, 0xFA, 0xDA, 0x0A, 0x06, 0xCC, 0x61, 0x0B, 0xCE,
+    0xEF, 0xC0, 0xC8, 0x36, 0xCF, 0xE8, 0x84, 0x2D, 0x27, 0x97, 0x03, 0x37,
+    0xDA, 0x48, 0x06, 0xC9, 0x20, 0xFF, 0x71, 0x5D, 0x02, 0x5E, 0xAB, 0xF3,
+    0x6D, 0x72, 0x2B, 0x2A, 0x02, 0x5E, 0xD4, 0x36, 0x8F, 0x68, 0x21, 0x03,
+    0x5F, 0xFF, 0x10, 0x80, 0xA8, 0xDA, 0x00};
+static const Color333 kQRCodePalette[1] = {{1, 1, 1}};
+const Sprite32 kQRCode = {25, 25, 1, 1, kQRCodeBits, kQRCodePalette};
+} // namespace Assets
@@ -0,0 +1,17 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+// Generated by assetpack (`make assets`) from assets/grid_logo.txt assets/qr.txt.
+// Edit the sources and regenerate instead of editing this file.
+
+#include "Sprite32.h"
+
+namespace Assets
+{
+// 8x10, 4 frames, 40 bytes packed (320 at a byte per pixel)
+extern const Sprite32 kGridLogo;
+// 25x25, 1 frame, 79 bytes packed (625 at a byte per pixel)
+extern const Sprite32 kQRCode;
+} // namespace Assets
+
+#endif // ASSETS_H
@@ -12,6 +12,7 @@ void BoidsScene::placeBoid(Boid *boid)
 {
     boid->position.x = Helpers::random(MATRIX_WIDTH);
     boid->position.y = Helpers::random(MATRIX_HEIGHT);
+    boid->previous = boid->position;
     long choice;
     choice = Helpers::random(1000);
     boid->velocity.x = ((choice % 2) ? 1 : -1) * (0.5 * MIN_SPEED + (MAX_SPEED - MIN_SPEED) * (choice / 1000.0));
@@ -137,6 +138,7 @@ void BoidsScene::updateBoid(AppContext &ctx, Boid *boid, Boid *flock)
         controlPlayerBoid(ctx);
     avoidEdges(boid);
     constrainSpeed(boid);
+    boid->previous = boid->position;
     boid->position = add(boid->position, boid->velocity);
     constrainPosition(boid);
 }
@@ -150,12 +152,14 @@ bool BoidsScene::isTooCloseToWall(int x, int y)
 }
 
 /*
-    Draw an individual Boid
+    Draw an individual Boid, alpha of the way from its previous position to its current one
 */
-void BoidsScene::drawBoid(Matrix32 &gfx, Boid *boid)
+void BoidsScene::drawBoid(GridMatrix &gfx, Boid *boid, double alpha)
 {
-    MatrixPosition x = round(boid->position.x);
-    MatrixPosition y = round(boid->position.y);
+    // Back off from the current position, so alpha 1 draws it exactly
+    const Vector at = sub(boid->position, multiply(sub(boid->position, boid->previous), 1.0 - alpha));
+    MatrixPosition x = round(at.x);
+    MatrixPosition y = round(at.y);
     bool isPlayer = (boid - flock == playerIndex);
     Color333 color = (isPlayer ? Color333{1, 4, 1} : DEFAULT_COLOR);
 
@@ -174,11 +178,31 @@ void BoidsScene::drawBoid(Matrix32 &gfx, Boid *boid)
             color = (isPlayer ? Color333{0, 4, 0} : SLOW_COLOR);
     }
 
+    if (x < MATRIX_WIDTH && y < MATRIX_HEIGHT)
+    {
+        const int16_t i = y * MATRIX_WIDTH + x;
+        drawn_[drawnCount_++] = Covered{i, gfx.codeAt(i)};
+    }
     gfx.drawPixel(x, y, color);
 }
 
+/*
+    Put back what the last render() covered, newest first so overlapping boids unwind correctly
+*/
+void BoidsScene::eraseDrawn(GridMatrix &gfx)
+{
+    while (drawnCount_)
+    {
+        const Covered &c = drawn_[--drawnCount_];
+        gfx.set(c.i % MATRIX_WIDTH, c.i / MATRIX_WIDTH, unpackColor333(c.under));
+    }
+}
+
 void BoidsScene::setup(AppContext &ctx)
 {
+    // 7 -> 4 -> 2 -> 1 -> 0: trails four frames long
+    trails_.decayKeep = 160;
+
     // position boids
     for (int i = 0; i < N_BOIDS; i++)
     {
@@ -188,17 +212,21 @@ void BoidsScene::setup(AppContext &ctx)
 
 void BoidsScene::loop(AppContext &ctx)
 {
-    // Clear background
-    ctx.gfx.clear();
+    // No clear: App fades the last frame (see postFX()), leaving trails.
+    // That fade already kept the last in-between boids, so they stay drawn.
+    drawnCount_ = 0;
 
     // update flock
     for (int i = 0; i < N_BOIDS; i++)
-    {
-        Boid *boid = &flock[i];
-        updateBoid(ctx, boid, flock);
-        drawBoid(ctx.gfx, boid);
-    }
+        updateBoid(ctx, &flock[i], flock);
+}
 
-    // show the frame
-    ctx.gfx.show();
+void BoidsScene::render(AppContext &ctx)
+{
+    // Between steps nothing fades, so the previous in-between boids would
+    // stay at full color: only the newest positions are drawn over the step
+    eraseDrawn(ctx.gfx);
+    const double alpha = ctx.time.alpha();
+    for (int i = 0; i < N_BOIDS; i++)
+        drawBoid(ctx.gfx, &flock[i], alpha);
 }
@@ -27,6 +27,7 @@
 
 struct Boid
 {
+  Vector previous; // position before the last step, for drawing in between
   Vector position;
   Vector velocity;
   Vector closeness;
@@ -40,6 +41,16 @@ class BoidsScene final : public Scene
   // creates flock
   Boid flock[N_BOIDS];
   int playerIndex = 0; // designate first boid as player Boids
+  PostFX32 trails_;
+  // Pixels render() drew since the last step and the codes they covered, so
+  // the next render() can put the step's frame back before drawing again
+  struct Covered
+  {
+    int16_t i; // y * MATRIX_WIDTH + x
+    uint16_t under;
+  };
+  Covered drawn_[N_BOIDS];
+  uint8_t drawnCount_ = 0;
 
   void placeBoid(Boid *boid);
   void constrainSpeed(Boid *boid);
@@ -51,7 +62,8 @@ class BoidsScene final : public Scene
   void flyWithFlock(Boid *boid, Boid *flock);
   void updateBoid(AppContext &ctx, Boid *boid, Boid *flock);
   bool isTooCloseToWall(int x, int y);
-  void drawBoid(Matrix32 &gfx, Boid *boid);
+  void drawBoid(GridMatrix &gfx, Boid *boid, double alpha);
+  void eraseDrawn(GridMatrix &gfx);
 
 public:
   SceneKind kind() const override { return SceneKind::Boids; }
@@ -60,6 +72,11 @@ public:
   SceneTimingPrefs timingPrefs() const override { return SceneTimingPrefs(16.6); }
   void setup(AppContext &ctx) override;
   void loop(AppContext &ctx) override;
+  // Boids step at 16.6 Hz; drawing between steps keeps their motion smooth
+  void render(AppContext &ctx) override;
+  bool interpolates() const override { return true; }
+  void resume(AppContext &) override { drawnCount_ = 0; }
+  const PostFX32 *postFX() const override { return &trails_; }
 };
 
 #endif
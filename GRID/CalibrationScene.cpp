@@ -28,6 +28,8 @@ void CalibrationScene::setup(AppContext &ctx)
     ctx.gfx.setCursor(1, 19);
     ctx.gfx.print("Calib");
 
+    // immediate mode coalesces presents; make sure the prompt is up before blocking
+    ctx.gfx.show();
     ctx.time.sleep(STAGE_MS);
     ctx.gfx.setImmediate(false);
 }
@@ -0,0 +1,60 @@
+#ifndef CANVAS32_H
+#define CANVAS32_H
+
+#include "Colors.h"
+#include "RasterMatrix32.h"
+
+// Offscreen 32x32 render target: the full Matrix32 drawing API into RAM.
+//
+// Pixels are packed Color333 codes (see packColor333): 2 KB per canvas, plus
+// about 100 bytes of drawing state (clip, origin, text, dirty rows).
+// show() presents nothing; it only marks the frame clean. capture() copies
+// a backend's current frame in, through the backend's codeAt(i) readback
+// (packed Color333 of pixel i), and blitTo() copies the canvas out again.
+class Canvas32 final : public RasterMatrix32<Canvas32>
+{
+public:
+    static constexpr int kPixels = MATRIX_WIDTH * MATRIX_HEIGHT;
+
+    // Packed Color333 codes (row-major)
+    uint16_t fb_[kPixels]{};
+
+    static constexpr int coordToIndex(int x, int y) { return y * MATRIX_WIDTH + x; }
+    Color333 get(int x, int y) const { return unpackColor333(fb_[coordToIndex(x, y)]); }
+    uint16_t codeAt(int i) const { return fb_[i]; }
+    const uint16_t *row(int y) const { return fb_ + y * MATRIX_WIDTH; }
+
+    // Copy src's current frame (anything with codeAt(i)) into the canvas
+    template <class Source>
+    void capture(const Source &src)
+    {
+        for (int i = 0; i < kPixels; ++i)
+            fb_[i] = src.codeAt(i);
+        markAllDirty();
+    }
+
+    // Write the whole canvas to dst with screen-space set() calls
+    template <class Target>
+    void blitTo(Target &dst) const
+    {
+        for (int y = 0; y < MATRIX_HEIGHT; ++y)
+            for (int x = 0; x < MATRIX_WIDTH; ++x)
+                dst.set(x, y, unpackColor333(fb_[coordToIndex(x, y)]));
+    }
+
+    // Matrix32 interface
+    void begin() override { clear(); }
+    void set(int x, int y, Color333 c) override
+    {
+        writePixel(x, y, c);
+        markRowDirty(y);
+    }
+    // Nothing to present
+    void show() override { dirtyRows_ = 0; }
+
+    uint16_t convertColor(Color333 c) const { return packColor333(c); }
+    // Never presents, so the immediate-mode throttle needs no clock
+    millis_t wallMs() const { return 0; }
+};
+
+#endif // CANVAS32_H
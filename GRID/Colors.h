@@ -27,6 +27,17 @@ struct Color888
     Intensity8 r, g, b; // RGB are each 0..255
 };
 
+// Color333 has only 512 values, so backends convert through tables indexed by the packed 9-bit code
+constexpr uint16_t COLOR333_COUNT = 512;
+constexpr uint16_t packColor333(Color333 c)
+{
+    return static_cast<uint16_t>(((c.r & 0x7) << 6) | ((c.g & 0x7) << 3) | (c.b & 0x7));
+}
+constexpr Color333 unpackColor333(uint16_t code)
+{
+    return Color333{Intensity3((code >> 6) & 0x7), Intensity3((code >> 3) & 0x7), Intensity3(code & 0x7)};
+}
+
 // Hue helper: degrees → internal hue units
 // Internally we use 6 segments (R→Y→G→C→B→M) of 256 steps each = 1536 total.
 constexpr uint16_t HUE_SEGMENTS = 6;                            // number of primary ramps
@@ -0,0 +1,534 @@
+#include "DisplayListMatrix32.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+inline void put16(uint8_t *p, int v)
+{
+    p[0] = uint8_t(v & 0xFF);
+    p[1] = uint8_t((v >> 8) & 0xFF);
+}
+
+inline int get16(const uint8_t *p) { return int16_t(uint16_t(p[0] | (p[1] << 8))); }
+
+inline Color333 colorOf(const uint8_t *cmd) { return unpackColor333(uint16_t(cmd[2] | (cmd[3] << 8))); }
+
+} // namespace
+
+// Payload bytes an op must carry (text: the fixed part before the characters)
+int DisplayListMatrix32::payloadBytes(uint8_t op)
+{
+    switch (op)
+    {
+    case OpLine:
+        return 8;
+    case OpCircle:
+    case OpFillCircle:
+        return 6;
+    case OpText:
+        return 5;
+    default:
+        return 0;
+    }
+}
+
+void DisplayListMatrix32::begin()
+{
+    target_.begin();
+    reset();
+    lastHash_ = 0;
+    dirtyRows_ = 0;
+}
+
+// Everything recorded so far would be painted over: start the list again
+void DisplayListMatrix32::clear()
+{
+    if (flushed_)
+        reset();
+    pending_.covered = uint16_t(pending_.covered + count_);
+    reset();
+    record(OpClear, 0, Color333{0, 0, 0}, Box{0, 0, MATRIX_WIDTH, MATRIX_HEIGHT});
+    markAllDirty();
+}
+
+// Raw screen-space pixel, as Matrix32::set (only on-matrix pixels are kept)
+void DisplayListMatrix32::set(int x, int y, Color333 c)
+{
+    if (x < 0 || x >= MATRIX_WIDTH || y < 0 || y >= MATRIX_HEIGHT)
+    {
+        ++pending_.offscreen;
+        return;
+    }
+    record(OpSet, 0, c, Box{x, y, x + 1, y + 1});
+}
+
+void DisplayListMatrix32::setImmediate(bool on)
+{
+    immediate = on;
+    target_.setImmediate(on);
+}
+
+void DisplayListMatrix32::show()
+{
+    flush();
+    presentsHeld_ = false;
+    target_.show();
+}
+
+void DisplayListMatrix32::drawChar(int x, int y, char ch, Color333 c)
+{
+    if (ch >= ASCII_START)
+        recordTextLine(x, y, &ch, 1, c);
+    endCall();
+}
+
+void DisplayListMatrix32::drawPixel(int x, int y, Color333 c)
+{
+    recordFill(x, y, 1, 1, c);
+    endCall();
+}
+
+void DisplayListMatrix32::drawLine(int x0, int y0, int x1, int y1, Color333 c)
+{
+    x0 += originX_;
+    y0 += originY_;
+    x1 += originX_;
+    y1 += originY_;
+    const Box box = clipBox(std::min(x0, x1), std::min(y0, y1), std::max(x0, x1) + 1, std::max(y0, y1) + 1);
+    if (box.empty())
+        ++pending_.offscreen;
+    else if (uint8_t *p = record(OpLine, payloadBytes(OpLine), c, box))
+    {
+        put16(p, x0);
+        put16(p + 2, y0);
+        put16(p + 4, x1);
+        put16(p + 6, y1);
+    }
+    endCall();
+}
+
+// Same edges as RasterMatrix32::drawRect, as four fills
+void DisplayListMatrix32::drawRect(int x, int y, int w, int h, Color333 c)
+{
+    if (w <= 0 || h <= 0)
+        return;
+    recordFill(x, y, w, 1, c);
+    recordFill(x, y + h - 1, w, 1, c);
+    recordFill(x, y, 1, h, c);
+    recordFill(x + w - 1, y, 1, h, c);
+    endCall();
+}
+
+void DisplayListMatrix32::drawCircle(int cx, int cy, int r, Color333 c)
+{
+    if (r < 0)
+        return;
+    cx += originX_;
+    cy += originY_;
+    const Box box = clipBox(cx - r, cy - r, cx + r + 1, cy + r + 1);
+    if (box.empty())
+        ++pending_.offscreen;
+    else if (uint8_t *p = record(OpCircle, payloadBytes(OpCircle), c, box))
+    {
+        put16(p, cx);
+        put16(p + 2, cy);
+        put16(p + 4, r);
+    }
+    endCall();
+}
+
+void DisplayListMatrix32::fillRect(int x, int y, int w, int h, Color333 c)
+{
+    recordFill(x, y, w, h, c);
+    endCall();
+}
+
+void DisplayListMatrix32::fillCircle(int cx, int cy, int r, Color333 c)
+{
+    if (r < 0)
+        return;
+    cx += originX_;
+    cy += originY_;
+    const Box box = clipBox(cx - r, cy - r, cx + r + 1, cy + r + 1);
+    if (box.empty())
+        ++pending_.offscreen;
+    else if (uint8_t *p = record(OpFillCircle, payloadBytes(OpFillCircle), c, box))
+    {
+        put16(p, cx);
+        put16(p + 2, cy);
+        put16(p + 4, r);
+    }
+    endCall();
+}
+
+void DisplayListMatrix32::print(char ch)
+{
+    const char s[2] = {ch, '\0'};
+    print(s);
+}
+
+void DisplayListMatrix32::print(const char *s)
+{
+    recordText(cx_, cy_, lineStartX_, s, tc_);
+    endCall();
+}
+
+void DisplayListMatrix32::println(const char *s)
+{
+    print(s);
+    print('\n');
+}
+
+void DisplayListMatrix32::drawText(int x, int y, const char *s, Color333 c)
+{
+    int tx = x, ty = y;
+    recordText(tx, ty, x, s, c);
+    endCall();
+}
+
+void DisplayListMatrix32::flush()
+{
+    if (flushed_)
+        reset(); // nothing recorded since the last flush: this frame is empty
+    optimize();
+    uint32_t hash = hashList(arena_, used_);
+    if (!hash)
+        hash = 1; // 0 means "no list shown"
+    pending_.bytes = uint16_t(used_);
+    pending_.reused = !spilled_ && hash == lastHash_;
+    if (!pending_.reused)
+    {
+        replayList(arena_, used_, target_);
+        pending_.replayed = uint16_t(pending_.replayed + count_);
+    }
+    lastHash_ = spilled_ ? 0 : hash;
+    stats_ = pending_;
+    pending_ = Stats{};
+    spilled_ = false;
+    flushed_ = true;
+    dirtyRows_ = 0;
+}
+
+size_t DisplayListMatrix32::serialize(uint8_t *out, size_t cap) const
+{
+    const size_t n = 6 + used_;
+    if (cap < n)
+        return 0;
+    out[0] = 'D';
+    out[1] = 'L';
+    out[2] = kVersion;
+    out[3] = 0;
+    put16(out + 4, count_);
+    std::memcpy(out + 6, arena_, used_);
+    return n;
+}
+
+bool DisplayListMatrix32::replay(const uint8_t *data, size_t n, Matrix32 &target)
+{
+    if (n < 6 || data[0] != 'D' || data[1] != 'L' || data[2] != kVersion)
+        return false;
+    const int count = uint16_t(get16(data + 4));
+    const uint8_t *p = data + 6;
+    const size_t len = n - 6;
+    // Validate every command before touching the target
+    size_t at = 0;
+    int seen = 0;
+    while (at < len)
+    {
+        if (len - at < size_t(kHeaderBytes))
+            return false;
+        const uint8_t op = p[at], size = p[at + 1];
+        if (op > OpClip || size < kHeaderBytes + payloadBytes(op) || at + size > len)
+            return false;
+        if (op != OpText && size != kHeaderBytes + payloadBytes(op))
+            return false;
+        if (op == OpText && size - kHeaderBytes - payloadBytes(op) > kMaxTextChars)
+            return false;
+        at += size;
+        ++seen;
+    }
+    if (seen != count)
+        return false;
+    replayList(p, len, target);
+    return true;
+}
+
+// Reserve a command in the arena; spills the list to the target when full
+uint8_t *DisplayListMatrix32::record(Op op, size_t payload, Color333 c, const Box &box)
+{
+    if (flushed_)
+        reset();
+    // Replay clips through the target: keep its clip in step with ours
+    // (clear() and set() ignore the clip, so they never need it)
+    const bool needsClip = op != OpClear && op != OpSet && op != OpClip;
+    const bool clipChanged = needsClip && (clip_.x0 != listClip_.x0 || clip_.y0 != listClip_.y0 ||
+                                           clip_.x1 != listClip_.x1 || clip_.y1 != listClip_.y1);
+    const size_t size = kHeaderBytes + payload + (clipChanged ? kHeaderBytes : 0);
+    if (used_ + size > kArenaBytes)
+    {
+        optimize();
+        replayList(arena_, used_, target_);
+        pending_.replayed = uint16_t(pending_.replayed + count_);
+        ++pending_.spills;
+        spilled_ = true;
+        reset();
+        return record(op, payload, c, box);
+    }
+    if (clipChanged)
+    {
+        uint8_t *clip = arena_ + used_;
+        clip[0] = OpClip;
+        clip[1] = kHeaderBytes;
+        clip[2] = clip[3] = 0;
+        setBox(clip, Box{clip_.x0, clip_.y0, clip_.x1, clip_.y1});
+        used_ += kHeaderBytes;
+        ++count_;
+        listClip_ = clip_;
+    }
+    uint8_t *cmd = arena_ + used_;
+    const uint16_t code = packColor333(c);
+    cmd[0] = op;
+    cmd[1] = uint8_t(kHeaderBytes + payload);
+    cmd[2] = uint8_t(code & 0xFF);
+    cmd[3] = uint8_t(code >> 8);
+    setBox(cmd, box);
+    used_ += kHeaderBytes + payload;
+    ++count_;
+    ++pending_.recorded;
+    for (int y = box.y0; y < box.y1; ++y)
+        markRowDirty(y);
+    return cmd + kHeaderBytes;
+}
+
+void DisplayListMatrix32::recordFill(int x, int y, int w, int h, Color333 c)
+{
+    x += originX_;
+    y += originY_;
+    const Box box = clipBox(x, y, x + w, y + h);
+    if (box.empty())
+        ++pending_.offscreen;
+    else
+        record(OpFill, 0, c, box);
+}
+
+// Same layout as RasterMatrix32::blitText: x advances per glyph, '\n' returns to lineX
+void DisplayListMatrix32::recordText(int &x, int &y, int lineX, const char *s, Color333 c)
+{
+    const char *run = s;
+    for (const char *p = s;; ++p)
+    {
+        if (*p && *p != '\n')
+            continue;
+        // Record [run, p) in chunks that fit one command
+        while (run < p)
+        {
+            const int n = std::min<int>(int(p - run), kMaxTextChars);
+            recordTextLine(x, y, run, n, c);
+            x += n * ts_ * FONT_CHAR_WIDTH;
+            run += n;
+        }
+        if (!*p)
+            break;
+        x = lineX;
+        y += ts_ * (FONT_CHAR_HEIGHT + 1);
+        run = p + 1;
+    }
+}
+
+void DisplayListMatrix32::recordTextLine(int x, int y, const char *s, int n, Color333 c)
+{
+    x += originX_;
+    y += originY_;
+    const Box box = clipBox(x, y, x + ((n - 1) * FONT_CHAR_WIDTH + FONT_GLYPH_WIDTH) * ts_,
+                            y + FONT_GLYPH_HEIGHT * ts_);
+    if (box.empty())
+    {
+        ++pending_.offscreen;
+        return;
+    }
+    if (uint8_t *p = record(OpText, size_t(payloadBytes(OpText) + n), c, box))
+    {
+        put16(p, x);
+        put16(p + 2, y);
+        p[4] = uint8_t(ts_);
+        std::memcpy(p + 5, s, size_t(n));
+    }
+}
+
+void DisplayListMatrix32::reset()
+{
+    used_ = 0;
+    count_ = 0;
+    flushed_ = false;
+    listClip_ = ClipRect{0, 0, MATRIX_WIDTH, MATRIX_HEIGHT};
+}
+
+// Cull covered commands, merge touching fills, then drop the dead ones
+void DisplayListMatrix32::optimize()
+{
+    uint16_t at[kArenaBytes / kHeaderBytes];
+    int n = 0;
+    for (size_t i = 0; i < used_; i += arena_[i + 1])
+        at[n++] = uint16_t(i);
+
+    for (int i = 0; i < n; ++i)
+    {
+        const uint8_t *fill = arena_ + at[i];
+        if (fill[0] != OpFill)
+            continue;
+        const Box b = boxOf(fill);
+        for (int j = 0; j < i; ++j)
+        {
+            uint8_t *cmd = arena_ + at[j];
+            if (cmd[0] & kDead || cmd[0] == OpClip)
+                continue;
+            const Box e = boxOf(cmd);
+            if (b.x0 <= e.x0 && e.x1 <= b.x1 && b.y0 <= e.y0 && e.y1 <= b.y1)
+            {
+                cmd[0] |= kDead;
+                ++pending_.covered;
+            }
+        }
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        uint8_t *fill = arena_ + at[i];
+        if (fill[0] != OpFill)
+            continue;
+        const Box b = boxOf(fill);
+        int scanned = 0;
+        for (int j = i - 1; j >= 0 && scanned < kMergeWindow; --j)
+        {
+            uint8_t *cmd = arena_ + at[j];
+            if (cmd[0] & kDead)
+                continue;
+            if (cmd[0] == OpClip)
+                break; // b was recorded under a different clip
+            ++scanned;
+            const Box e = boxOf(cmd);
+            // Moving b back to j is only safe if nothing in between overlaps it
+            if (cmd[0] == OpFill && cmd[2] == fill[2] && cmd[3] == fill[3] &&
+                ((e.y0 == b.y0 && e.y1 == b.y1 && e.x1 >= b.x0 && b.x1 >= e.x0) ||
+                 (e.x0 == b.x0 && e.x1 == b.x1 && e.y1 >= b.y0 && b.y1 >= e.y0)))
+            {
+                setBox(cmd, Box{std::min(e.x0, b.x0), std::min(e.y0, b.y0), std::max(e.x1, b.x1), std::max(e.y1, b.y1)});
+                fill[0] |= kDead;
+                ++pending_.merged;
+                break;
+            }
+            if (e.x0 < b.x1 && b.x0 < e.x1 && e.y0 < b.y1 && b.y0 < e.y1)
+                break;
+        }
+    }
+
+    size_t out = 0;
+    count_ = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        const uint8_t *cmd = arena_ + at[i];
+        if (cmd[0] & kDead)
+            continue;
+        const uint8_t size = cmd[1];
+        if (out != at[i])
+            std::memmove(arena_ + out, cmd, size);
+        out += size;
+        ++count_;
+    }
+    used_ = out;
+}
+
+void DisplayListMatrix32::endCall()
+{
+    if (immediate)
+        flush();
+}
+
+DisplayListMatrix32::Box DisplayListMatrix32::clipBox(int x0, int y0, int x1, int y1) const
+{
+    return Box{std::max<int>(x0, clip_.x0), std::max<int>(y0, clip_.y0),
+               std::min<int>(x1, clip_.x1), std::min<int>(y1, clip_.y1)};
+}
+
+DisplayListMatrix32::Box DisplayListMatrix32::boxOf(const uint8_t *cmd)
+{
+    return Box{cmd[4], cmd[5], cmd[6], cmd[7]};
+}
+
+void DisplayListMatrix32::setBox(uint8_t *cmd, const Box &b)
+{
+    cmd[4] = uint8_t(b.x0);
+    cmd[5] = uint8_t(b.y0);
+    cmd[6] = uint8_t(b.x1);
+    cmd[7] = uint8_t(b.y1);
+}
+
+// Rasterize commands in screen coordinates (origin reset, clip as recorded)
+void DisplayListMatrix32::replayList(const uint8_t *p, size_t n, Matrix32 &target)
+{
+    const bool moved = target.pushOrigin(-target.originX(), -target.originY());
+    bool clipped = false;
+    int ts = 0;
+    char text[kMaxTextChars + 1];
+    for (size_t i = 0; i < n; i += p[i + 1])
+    {
+        const uint8_t *cmd = p + i;
+        const uint8_t *arg = cmd + kHeaderBytes;
+        const Box b = boxOf(cmd);
+        const Color333 c = colorOf(cmd);
+        switch (cmd[0])
+        {
+        case OpClear:
+            target.clear();
+            break;
+        case OpFill:
+            target.fillRect(b.x0, b.y0, b.x1 - b.x0, b.y1 - b.y0, c);
+            break;
+        case OpSet:
+            target.set(b.x0, b.y0, c);
+            break;
+        case OpLine:
+            target.drawLine(get16(arg), get16(arg + 2), get16(arg + 4), get16(arg + 6), c);
+            break;
+        case OpCircle:
+            target.drawCircle(get16(arg), get16(arg + 2), get16(arg + 4), c);
+            break;
+        case OpFillCircle:
+            target.fillCircle(get16(arg), get16(arg + 2), get16(arg + 4), c);
+            break;
+        case OpText:
+        {
+            if (arg[4] != ts)
+            {
+                ts = arg[4];
+                target.setTextSize(ts);
+            }
+            const int len = cmd[1] - kHeaderBytes - payloadBytes(OpText);
+            std::memcpy(text, arg + 5, size_t(len));
+            text[len] = '\0';
+            target.drawText(get16(arg), get16(arg + 2), text, c);
+            break;
+        }
+        case OpClip:
+            if (clipped)
+                target.popClip();
+            clipped = !(b.x0 == 0 && b.y0 == 0 && b.x1 == MATRIX_WIDTH && b.y1 == MATRIX_HEIGHT) &&
+                      target.pushClip(b.x0, b.y0, b.x1 - b.x0, b.y1 - b.y0);
+            break;
+        }
+    }
+    if (clipped)
+        target.popClip();
+    if (moved)
+        target.popOrigin();
+}
+
+// FNV-1a over the list bytes
+uint32_t DisplayListMatrix32::hashList(const uint8_t *p, size_t n)
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; ++i)
+        h = (h ^ p[i]) * 16777619u;
+    return h;
+}
@@ -0,0 +1,160 @@
+#ifndef DISPLAY_LIST_MATRIX32_H
+#define DISPLAY_LIST_MATRIX32_H
+
+#include "Matrix32.h"
+#include <cstddef>
+#include <cstdint>
+
+// Matrix32 decorator that records draw calls into a display list and
+// rasterizes them into a target matrix in one pass.
+//
+// Every call is stored as a compact command in a fixed arena, already
+// translated to screen space and tagged with its clipped bounding box.
+// Commands that land fully off screen (or outside the clip) are dropped on
+// record. flush() then
+//   - culls commands completely covered by a later opaque fillRect,
+//   - merges same-colored fills that touch into one rectangle (the column
+//     runs blitCols() emits collapse into a handful of rects),
+//   - and replays what is left into the target, unless the list is identical
+//     to the one replayed last time (the target already shows it).
+// Outlines (drawRect), drawPixel and blitCols() are recorded as fills; text is
+// recorded one line per command. clear() drops everything recorded before it.
+//
+// The list just flushed can be serialized, to diff frames, count commands per
+// scene or replay them on another backend with replay().
+//
+// The decorator assumes it owns the target between flushes: anything drawn
+// straight to the target must be followed by invalidate(). Replay leaves the
+// target's text scale at the last scale used. Costs kArenaBytes of RAM; when a
+// frame outgrows the arena, the commands so far are replayed early.
+class DisplayListMatrix32 final : public Matrix32
+{
+public:
+    static constexpr size_t kArenaBytes = 1024;
+
+    // Per-flush counters (see stats())
+    struct Stats
+    {
+        uint16_t recorded;  // commands recorded since the previous flush
+        uint16_t offscreen; // draw calls dropped on record (nothing visible)
+        uint16_t covered;   // commands culled under a later fill
+        uint16_t merged;    // fills folded into a neighbour
+        uint16_t replayed;  // commands sent to the target
+        uint16_t spills;    // early replays because the arena was full
+        uint16_t bytes;     // size of the flushed list
+        bool reused;        // list matched the last one; nothing was replayed
+    };
+
+    explicit DisplayListMatrix32(Matrix32 &target) : target_(target) {}
+
+    // Optimize and replay the recorded commands into the target without presenting it
+    void flush();
+    // Next flush() replays even if the list did not change
+    void invalidate() { lastHash_ = 0; }
+    // Counters of the last flush()
+    const Stats &stats() const { return stats_; }
+
+    // Serialized form of the list: after flush(), the optimized list that was
+    // replayed. A 6-byte header ("DL", version, 0, command count) followed by
+    // the commands. Returns the bytes written, or 0 if cap is too small.
+    size_t serialize(uint8_t *out, size_t cap) const;
+    // Replay a serialize()d list into target in screen coordinates; false if it is malformed
+    static bool replay(const uint8_t *data, size_t n, Matrix32 &target);
+
+    // Matrix32
+    void begin() override;
+    void clear() override;
+    void set(int x, int y, Color333 c) override;
+    void setImmediate(bool on) override;
+    // flush() and present the target
+    void show() override;
+
+    void drawChar(int x, int y, char ch, Color333 c) override;
+    void drawPixel(int x, int y, Color333 c) override;
+    void drawLine(int x0, int y0, int x1, int y1, Color333 c) override;
+    void drawRect(int x, int y, int w, int h, Color333 c) override;
+    void drawCircle(int cx, int cy, int r, Color333 c) override;
+    void fillRect(int x, int y, int w, int h, Color333 c) override;
+    void fillCircle(int cx, int cy, int r, Color333 c) override;
+
+    void advance() override { cx_ += ts_ * FONT_CHAR_WIDTH; }
+    void setCursor(int x, int y) override
+    {
+        cx_ = x;
+        cy_ = y;
+        lineStartX_ = x;
+    }
+    void setTextColor(Color333 c) override { tc_ = c; }
+    void setTextSize(int s) override { ts_ = s < 1 ? 1 : s; }
+    void print(char ch) override;
+    void print(const char *s) override;
+    void println(const char *s) override;
+    void drawText(int x, int y, const char *s, Color333 c) override;
+
+private:
+    // Command layout: an 8-byte header followed by the payload
+    //   [0] Op (kDead set once culled)  [1] total size in bytes
+    //   [2..3] packed Color333 (little-endian)
+    //   [4..7] bounding box x0, y0, x1, y1 in screen pixels (half-open, clipped)
+    // Payload: Line x0,y0,x1,y1 / Circle, FillCircle cx,cy,r as int16 LE;
+    // Text x,y as int16 LE, scale, then the characters. Fill, Set, Clear and
+    // Clip carry no payload: the box is the rectangle. A Clip command precedes
+    // the first clipped command recorded under a new clip rectangle.
+    enum Op : uint8_t
+    {
+        OpClear,
+        OpFill,
+        OpSet,
+        OpLine,
+        OpCircle,
+        OpFillCircle,
+        OpText,
+        OpClip
+    };
+    static constexpr uint8_t kDead = 0x80;
+    static constexpr int kHeaderBytes = 8;
+    static constexpr int kMaxTextChars = 64;
+    static constexpr int kMergeWindow = 16; // commands scanned back for a merge
+    static constexpr uint8_t kVersion = 1;
+
+    struct Box
+    {
+        int x0, y0, x1, y1;
+        bool empty() const { return x0 >= x1 || y0 >= y1; }
+    };
+
+    Matrix32 &target_;
+    uint8_t arena_[kArenaBytes];
+    size_t used_{0};
+    uint16_t count_{0};
+    bool flushed_{false}; // arena holds the last flushed list until the next record
+    bool spilled_{false}; // part of this frame was replayed early
+    uint32_t lastHash_{0};
+    Stats stats_{};
+    Stats pending_{};
+    ClipRect listClip_{0, 0, MATRIX_WIDTH, MATRIX_HEIGHT}; // clip in effect at the list tail
+
+    // Text state, as in RasterMatrix32
+    int cx_{0};
+    int cy_{0};
+    int lineStartX_{0};
+    int ts_{1};
+    Color333 tc_{Color333{7, 7, 7}};
+
+    uint8_t *record(Op op, size_t payload, Color333 c, const Box &box);
+    void recordFill(int x, int y, int w, int h, Color333 c);
+    void recordText(int &x, int &y, int lineX, const char *s, Color333 c);
+    void recordTextLine(int x, int y, const char *s, int n, Color333 c);
+    void reset();
+    void optimize();
+    void endCall();
+
+    Box clipBox(int x0, int y0, int x1, int y1) const;
+    static Box boxOf(const uint8_t *cmd);
+    static void setBox(uint8_t *cmd, const Box &b);
+    static void replayList(const uint8_t *p, size_t n, Matrix32 &target);
+    static uint32_t hashList(const uint8_t *p, size_t n);
+    static int payloadBytes(uint8_t op);
+};
+
+#endif // DISPLAY_LIST_MATRIX32_H
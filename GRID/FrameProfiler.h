@@ -0,0 +1,166 @@
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include "Logging.h"
+#include "Timing.h"
+#include <cstdint>
+
+// Fixed-bucket log2 latency histogram in microseconds: bucket 0 counts
+// 0..1 us, bucket i counts [2^i, 2^(i+1)) us and the last bucket everything
+// from ~0.5 s up. 16-bit counts keep it at 44 bytes; when one would
+// overflow, all are halved, which keeps the shape (and the percentiles).
+struct LatencyHistogram
+{
+    static constexpr uint8_t kBuckets = 20;
+
+    uint16_t counts[kBuckets];
+    uint32_t maxUs;
+
+    void reset()
+    {
+        for (uint8_t i = 0; i < kBuckets; ++i)
+            counts[i] = 0;
+        maxUs = 0;
+    }
+
+    void add(uint32_t us)
+    {
+        uint8_t b = 0;
+        for (uint32_t v = us; v > 1 && b < kBuckets - 1; v >>= 1)
+            ++b;
+        if (counts[b] == UINT16_MAX)
+            for (uint8_t i = 0; i < kBuckets; ++i)
+                counts[i] = uint16_t(counts[i] >> 1);
+        ++counts[b];
+        if (us > maxUs)
+            maxUs = us;
+    }
+
+    uint32_t samples() const
+    {
+        uint32_t n = 0;
+        for (uint8_t i = 0; i < kBuckets; ++i)
+            n += counts[i];
+        return n;
+    }
+
+    // Upper bound of the bucket holding the p-th percentile (1..100), capped
+    // at the max: within 2x of the true value, never below it
+    uint32_t percentile(uint8_t p) const
+    {
+        const uint32_t n = samples();
+        if (!n)
+            return 0;
+        const uint32_t rank = (n * p + 99) / 100; // 1-based
+        uint32_t seen = 0;
+        for (uint8_t i = 0; i < kBuckets; ++i)
+        {
+            seen += counts[i];
+            if (seen >= rank)
+            {
+                const uint32_t upper = (uint32_t(2) << i) - 1;
+                return upper < maxUs ? upper : maxUs;
+            }
+        }
+        return maxUs;
+    }
+};
+
+// Per-phase frame profiler. App times each phase with a Scope, records the
+// interval between presented frames, and logs one summary line a second
+// with p50/p95/p99/max of every phase since the scene started; App logs the
+// measured frame rate (measuredFps()) just before it. Times come from
+// Timing::nowUs(), so the same code runs on the emulator and on the Metro
+// (over Serial, ~240 bytes of RAM).
+class FrameProfiler
+{
+public:
+    enum Phase : uint8_t
+    {
+        Input, // Input::sample()
+        Loop,  // Scene::loop()
+        Show,  // Matrix32::show()
+        Flush, // ILogger::flush()
+        Frame, // presented frame to presented frame
+        kPhases
+    };
+
+    // Times one phase from construction to destruction
+    class Scope
+    {
+        FrameProfiler &profiler_;
+        Phase phase_;
+        uint32_t t0_;
+
+    public:
+        Scope(FrameProfiler &profiler, Phase phase)
+            : profiler_(profiler), phase_(phase), t0_(profiler.time_.nowUs()) {}
+        ~Scope() { profiler_.record(phase_, profiler_.time_.nowUs() - t0_); }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+    };
+
+    explicit FrameProfiler(const Timing &time) : time_(time) { reset("-"); }
+
+    // Start over for a new scene
+    void reset(const char *scene)
+    {
+        scene_ = scene;
+        for (uint8_t i = 0; i < kPhases; ++i)
+            phases_[i].reset();
+        lastFrameUs_ = 0;
+        framesSinceLog_ = 0;
+        logStartUs_ = time_.nowUs();
+    }
+
+    void record(Phase phase, uint32_t us) { phases_[phase].add(us); }
+
+    // Mark a presented frame; the first one after a reset only starts the clock
+    void frameDone()
+    {
+        const uint32_t now = time_.nowUs();
+        if (lastFrameUs_)
+            record(Frame, now - lastFrameUs_);
+        lastFrameUs_ = now ? now : 1;
+        ++framesSinceLog_;
+    }
+
+    // Frames per second measured since the last log()
+    float measuredFps() const
+    {
+        const uint32_t us = time_.nowUs() - logStartUs_;
+        return us ? float(framesSinceLog_) * 1e6f / float(us) : 0.0f;
+    }
+
+    const LatencyHistogram &phase(Phase p) const { return phases_[p]; }
+
+    // One summary line (Debug level), then a new window for measuredFps()
+    void log(ILogger &logger)
+    {
+        const LatencyHistogram &in = phases_[Input], &lp = phases_[Loop], &sh = phases_[Show],
+                               &fl = phases_[Flush], &fr = phases_[Frame];
+        logger.logf(LogLevel::Debug,
+                    "Profile %s (us p50/p95/p99/max): input %lu/%lu/%lu/%lu loop %lu/%lu/%lu/%lu "
+                    "show %lu/%lu/%lu/%lu flush %lu/%lu/%lu/%lu frame %lu/%lu/%lu/%lu",
+                    scene_,
+                    ul(in.percentile(50)), ul(in.percentile(95)), ul(in.percentile(99)), ul(in.maxUs),
+                    ul(lp.percentile(50)), ul(lp.percentile(95)), ul(lp.percentile(99)), ul(lp.maxUs),
+                    ul(sh.percentile(50)), ul(sh.percentile(95)), ul(sh.percentile(99)), ul(sh.maxUs),
+                    ul(fl.percentile(50)), ul(fl.percentile(95)), ul(fl.percentile(99)), ul(fl.maxUs),
+                    ul(fr.percentile(50)), ul(fr.percentile(95)), ul(fr.percentile(99)), ul(fr.maxUs));
+        framesSinceLog_ = 0;
+        logStartUs_ = time_.nowUs();
+    }
+
+private:
+    static unsigned long ul(uint32_t v) { return static_cast<unsigned long>(v); }
+
+    const Timing &time_;
+    const char *scene_;
+    LatencyHistogram phases_[kPhases];
+    uint32_t lastFrameUs_;
+    uint32_t framesSinceLog_;
+    uint32_t logStartUs_;
+};
+
+#endif // FRAME_PROFILER_H
@@ -47,7 +47,7 @@ using frames_t = uint16_t; // convenience alias for frame counts
 // Globals
 
 static FlashStorage storage(g_flash, g_fatfs);
-static RGBmatrixPanel panel(A, B, C, D, CLK, LAT, OE, false);
+static RGBmatrixPanel panel(A, B, C, D, CLK, LAT, OE, false, MATRIX_WIDTH); // width covers chained panels
 static RGBMatrix32 gfx{panel};
 static ArduinoPassiveTiming timing{TICK_HZ};
 static SerialSink sink;
@@ -86,6 +86,18 @@ void setup()
     calib.load(storage, logger);
     input.setCalibration(calib);
 
+    // RAM report: framebuffer mode and size (see GRID_INDEXED_FB in RGBMatrix32.h)
+#if defined(GRID_INDEXED_FB)
+    logger.logf(LogLevel::Info, "Framebuffer: %d-bit indexed, %u bytes (direct: %u), free RAM: %d",
+                GRID_INDEXED_FB, unsigned(sizeof(gfx.fb_)), unsigned(sizeof(PanelColor) * MATRIX_WIDTH * MATRIX_HEIGHT),
+                Helpers::freeRam());
+#else
+    logger.logf(LogLevel::Info, "Framebuffer: direct, %u bytes, free RAM: %d",
+                unsigned(sizeof(gfx.fb_)), Helpers::freeRam());
+#endif
+
+    // Blend/Wipe/Slide log their step cost and peak free RAM at Debug level
+    app.setTransition(Transition32::Kind::Cut);
     app.setScene<StartScene>();
     prev_millis = millis();
     log_last_ms = prev_millis;
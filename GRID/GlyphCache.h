@@ -0,0 +1,88 @@
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include "Matrix32.h"
+#include <cstdint>
+
+// Row-major view of the 5x7 font for the text blitter.
+//
+// FONT5x7 stores each glyph column-major (bit = row). The blitter wants one
+// bitmask per glyph row instead, so it can fill whole horizontal runs. Rows
+// are transposed once on first use; for scales > 1 a 32-entry table expands
+// each 5-bit row into its scaled 32-bit mask and is rebuilt only when the
+// text scale changes. The tables are the same for every target, so all
+// drawing backends and canvases share one instance (~800 bytes of RAM).
+class GlyphCache
+{
+public:
+    // The instance every RasterMatrix32 backend draws text with
+    static GlyphCache &shared()
+    {
+        static GlyphCache cache;
+        return cache;
+    }
+
+    using RowBits = uint32_t; // bit i = glyph-local screen column i
+
+    static constexpr int kGlyphCount = 96;                                     // ' '..'~' plus DEL
+    static constexpr int kMaxScale = int(sizeof(RowBits) * 8) / FONT_GLYPH_WIDTH; // widest scale that fits one mask
+
+    // Scale-1 row masks of ch (FONT_GLYPH_HEIGHT entries), or nullptr for blank/unknown glyphs
+    const uint8_t *rows(char ch)
+    {
+        const unsigned idx = static_cast<unsigned char>(ch) - unsigned(ASCII_START);
+        if (idx >= unsigned(kGlyphCount))
+            return nullptr;
+        if (!built_)
+            buildRows();
+        return rows_[idx];
+    }
+
+    // Expand one scale-1 row mask to scale ts (1..kMaxScale)
+    RowBits scaled(uint8_t bits, int ts)
+    {
+        if (ts == 1)
+            return bits;
+        if (ts != expandScale_)
+            buildScale(ts);
+        return expand_[bits];
+    }
+
+private:
+    uint8_t rows_[kGlyphCount][FONT_GLYPH_HEIGHT]{};
+    RowBits expand_[1 << FONT_GLYPH_WIDTH]{};
+    int expandScale_{0}; // scale expand_ was built for (0 = none)
+    bool built_{false};
+
+    // Transpose FONT5x7 columns into per-row masks (bit 0 = leftmost column)
+    void buildRows()
+    {
+        for (int g = 0; g < kGlyphCount; ++g)
+            for (int row = 0; row < FONT_GLYPH_HEIGHT; ++row)
+            {
+                uint8_t bits = 0;
+                for (int col = 0; col < FONT_GLYPH_WIDTH; ++col)
+                    if (FONT5x7[g][col] & (1u << row))
+                        bits |= uint8_t(1u << col);
+                rows_[g][row] = bits;
+            }
+        built_ = true;
+    }
+
+    // Each set bit becomes ts adjacent set bits
+    void buildScale(int ts)
+    {
+        const RowBits block = (RowBits(1) << ts) - 1;
+        for (int bits = 0; bits < (1 << FONT_GLYPH_WIDTH); ++bits)
+        {
+            RowBits m = 0;
+            for (int col = 0; col < FONT_GLYPH_WIDTH; ++col)
+                if (bits & (1 << col))
+                    m |= block << (col * ts);
+            expand_[bits] = m;
+        }
+        expandScale_ = ts;
+    }
+};
+
+#endif // GLYPH_CACHE_H
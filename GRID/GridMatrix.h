@@ -0,0 +1,19 @@
+#ifndef GRID_MATRIX_H
+#define GRID_MATRIX_H
+
+// Compile-time choice of the Matrix32 backend for this build. Scenes draw
+// through GridMatrix so primitive calls and setSafe() bind statically to the
+// backend's final overrides; Matrix32& keeps working for tools and helpers
+// that must stay backend-agnostic.
+#if defined(GRID_HEADLESS)
+#include "MemoryMatrix32.h"
+using GridMatrix = MemoryMatrix32;
+#elif defined(GRID_EMULATION)
+#include "SDLMatrix32.h"
+using GridMatrix = SDLMatrix32;
+#else
+#include "RGBMatrix32.h"
+using GridMatrix = RGBMatrix32;
+#endif
+
+#endif // GRID_MATRIX_H
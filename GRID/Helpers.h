@@ -30,10 +30,25 @@ namespace Helpers
 // Helpers for use by the emulation
 #ifdef GRID_EMULATION
 
+#include <chrono>
+
+// Headless builds (GRID_HEADLESS) run without SDL at all
+#ifndef GRID_HEADLESS
 #include <SDL.h>
+#endif
 
 using byte = uint8_t; // Mimic the byte alias in Arduino-land
 
+namespace Helpers
+{
+    // Free-running microsecond counter for short cost measurements (wraps like Arduino micros())
+    inline uint32_t microsNow()
+    {
+        using namespace std::chrono;
+        return static_cast<uint32_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+}
+
 #else
 
 #include <Arduino.h>
@@ -116,6 +131,9 @@ namespace Helpers
         return out;
     }
 
+    // Free-running microsecond counter for short cost measurements
+    inline uint32_t microsNow() { return micros(); }
+
     extern "C" char *sbrk(int incr);
     static inline int freeRam()
     {
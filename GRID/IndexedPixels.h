@@ -0,0 +1,159 @@
+#ifndef INDEXED_PIXELS_H
+#define INDEXED_PIXELS_H
+
+#include "Colors.h"
+#include "Matrix32.h"
+#include <cstdint>
+#include <cstring>
+
+// Palette-indexed 32x32 pixel storage for RAM-tight backends.
+//
+// Each pixel holds a Bits-wide palette index (4 bits = two pixels per byte,
+// 8 bits = one) and the palette holds packed Color333 codes; the backend
+// resolves indices to panel colors only when it pushes rows in show().
+// Colors are added to the palette on first use. When it is full, new colors
+// map to the nearest entry. Filling the whole frame (clear(), a full-screen
+// fillRect) starts a fresh palette from the requested color, so scenes that
+// redraw every frame never run out. A scene can also
+// preload its colors with setPalette().
+//
+//   Bits  pixels   palette  (direct PanelColor framebuffer: 2048 bytes)
+//   4      512 B     32 B
+//   8     1024 B    512 B
+template <int Bits>
+class IndexedPixels
+{
+    static_assert(Bits == 4 || Bits == 8, "IndexedPixels supports 4- or 8-bit indices");
+
+public:
+    using Index = uint8_t;
+    static constexpr int kColors = 1 << Bits;
+    static constexpr int kPixels = MATRIX_WIDTH * MATRIX_HEIGHT;
+    static constexpr int kBytes = kPixels * Bits / 8; // pixel storage
+
+    IndexedPixels() { resetPalette(0); }
+
+    // Palette slot for c: an existing entry, else a new one, else the nearest
+    Index indexOf(Color333 c)
+    {
+        const uint16_t code = packColor333(c);
+        if (code == lastCode_)
+            return lastIndex_;
+        int found = -1;
+        for (int i = 0; i < used_; ++i)
+            if (palette_[i] == code)
+            {
+                found = i;
+                break;
+            }
+        if (found < 0 && used_ < kColors)
+        {
+            found = used_++;
+            palette_[found] = code;
+        }
+        else if (found < 0)
+            found = nearest(c);
+        lastCode_ = code;
+        lastIndex_ = Index(found);
+        return lastIndex_;
+    }
+
+    // Replace the palette with colors[0..n) (clamped to kColors); pixels keep their indices
+    void setPalette(const Color333 *colors, int n)
+    {
+        used_ = uint16_t(n < 0 ? 0 : n < kColors ? n : kColors);
+        for (int i = 0; i < used_; ++i)
+            palette_[i] = packColor333(colors[i]);
+        lastCode_ = kNoCode;
+    }
+    int paletteSize() const { return used_; }
+
+    // Packed Color333 code of palette slot i
+    uint16_t code(Index i) const { return palette_[i]; }
+    // Packed Color333 code of pixel i (row-major)
+    uint16_t codeAt(int i) const { return palette_[at(i)]; }
+
+    // Index stored at pixel i
+    Index at(int i) const
+    {
+        if (Bits == 8)
+            return px_[i];
+        return (px_[i >> 1] >> ((i & 1) * 4)) & 0xF;
+    }
+
+    void store(int i, Index v)
+    {
+        if (Bits == 8)
+            px_[i] = v;
+        else
+        {
+            uint8_t &b = px_[i >> 1];
+            b = (i & 1) ? uint8_t((b & 0x0F) | (v << 4)) : uint8_t((b & 0xF0) | v);
+        }
+    }
+
+    // Fill the whole frame with c and restart the palette with it as entry 0.
+    // Takes the color, not an index: with a full palette indexOf(c) would be
+    // the nearest entry, and the frame would restart from the wrong color.
+    void fillFrame(Color333 c)
+    {
+        resetPalette(packColor333(c));
+        fill(0, kPixels, 0);
+    }
+
+    // Store v at pixels [i, i+n)
+    void fill(int i, int n, Index v)
+    {
+        if (n <= 0)
+            return;
+        if (Bits == 8)
+        {
+            std::memset(px_ + i, v, size_t(n));
+            return;
+        }
+        if (i & 1)
+        {
+            store(i++, v);
+            --n;
+        }
+        std::memset(px_ + (i >> 1), v | (v << 4), size_t(n >> 1));
+        if (n & 1)
+            store(i + n - 1, v);
+    }
+
+private:
+    static constexpr uint16_t kNoCode = 0xFFFF;
+
+    uint8_t px_[kBytes]{};
+    uint16_t palette_[kColors]{};
+    uint16_t used_{0};
+    uint16_t lastCode_{kNoCode}; // one-entry cache: most primitives reuse one color
+    Index lastIndex_{0};
+
+    void resetPalette(uint16_t firstCode)
+    {
+        palette_[0] = firstCode;
+        used_ = 1;
+        lastCode_ = kNoCode;
+    }
+
+    // Closest palette entry to c by squared 3-bit RGB distance
+    int nearest(Color333 c) const
+    {
+        int best = 0, bestDist = 1 << 30;
+        for (int i = 0; i < used_; ++i)
+        {
+            const Color333 p = unpackColor333(palette_[i]);
+            const int dr = int(p.r) - c.r, dg = int(p.g) - c.g, db = int(p.b) - c.b;
+            const int d = dr * dr + dg * dg + db * db;
+            if (d < bestDist)
+            {
+                best = i;
+                bestDist = d;
+            }
+        }
+        return best;
+    }
+};
+
+#endif // INDEXED_PIXELS_H
@@ -112,21 +112,21 @@ void LifeScene::runSimulation(AppContext &ctx)
     }
 }
 
-void LifeScene::drawCells(Matrix32 &gfx)
+void LifeScene::drawCells(GridMatrix &gfx)
 {
+    // Emit each row as runs of equal cells so the backend fills whole spans
     for (int y = 0; y < MATRIX_HEIGHT; ++y)
     {
-        for (int x = 0; x < MATRIX_WIDTH; ++x)
+        int runStart = 0;
+        bool runAlive = cells.test(index(0, y));
+        for (int x = 1; x <= MATRIX_WIDTH; ++x)
         {
-            int idx = index(x, y);
-            if (cells.test(idx))
-            {
-                gfx.setSafe(x, y, ALIVE_COLOR);
-            }
-            else
-            {
-                gfx.setSafe(x, y, DEAD_COLOR);
-            }
+            const bool alive = x < MATRIX_WIDTH && cells.test(index(x, y));
+            if (x < MATRIX_WIDTH && alive == runAlive)
+                continue;
+            gfx.fillSpan(runStart, x - 1, y, runAlive ? ALIVE_COLOR : DEAD_COLOR);
+            runStart = x;
+            runAlive = alive;
         }
     }
 }
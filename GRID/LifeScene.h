@@ -22,7 +22,7 @@ class LifeScene final : public Scene
         return y * MATRIX_WIDTH + x;
     }
 
-    void drawCells(Matrix32 &gfx);
+    void drawCells(GridMatrix &gfx);
     void updateCursor(AppContext &ctx);
     void drawCursor(AppContext &ctx);
     void runSimulation(AppContext &ctx);
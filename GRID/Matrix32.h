@@ -2,12 +2,13 @@
 #define MATRIX32_H
 
 #include "Colors.h"
+#include "PanelGeometry.h"
+#include "Sprite32.h"
 #include <cstdint>
 #include <vector>
 
-#define MATRIX_SIZE 32
-#define MATRIX_WIDTH 32
-#define MATRIX_HEIGHT 32
+#define MATRIX_WIDTH GRID_PANEL_WIDTH
+#define MATRIX_HEIGHT GRID_PANEL_HEIGHT
 #define ASCII_START 32
 #define FONT_GLYPH_WIDTH 5
 #define FONT_GLYPH_HEIGHT 7
@@ -17,6 +18,7 @@
 using MatrixPosition = uint8_t;
 using PixelMap = uint8_t;
 using PixelColumn = uint8_t;
+using RowMask = Geometry::RowMask; // one bit per matrix row (bit y = row y)
 
 // 5x7 ASCII font declaration (defined elsewhere)
 extern const PixelMap FONT5x7[96][5];
@@ -30,17 +32,84 @@ public:
     // Set a pixel (bounds are NOT checked)
     virtual void set(int x, int y, Color333 c) = 0;
 
-    // Safe setter with bounds check
+    // Safe setter: (x,y) is relative to the current origin and clipped
     inline void setSafe(int x, int y, Color333 c)
     {
-        if (0 <= x && x < MATRIX_WIDTH && 0 <= y && y < MATRIX_HEIGHT)
+        x += originX_;
+        y += originY_;
+        if (inClip(x, y))
             set(x, y, c);
     }
 
-    // Immediate mode control: if true, show() is called after each draw operation.
+    // Clip and origin stacks. Every drawing call below (and setSafe) takes
+    // coordinates relative to the current origin and only touches pixels inside
+    // the current clip rectangle; set() and clear() ignore both. Clips nest by
+    // intersection, origins by translation. A push returns false and changes
+    // nothing when its stack already holds kStackDepth entries.
+    static constexpr int kStackDepth = 4;
+
+    // Restrict drawing to the w x h rectangle at (x,y), in current coordinates
+    bool pushClip(int x, int y, int w, int h)
+    {
+        if (clipDepth_ >= kStackDepth)
+            return false;
+        clipStack_[clipDepth_++] = clip_;
+        x += originX_;
+        y += originY_;
+        clip_.x0 = int16_t(clampInt(x, clip_.x0, clip_.x1));
+        clip_.y0 = int16_t(clampInt(y, clip_.y0, clip_.y1));
+        clip_.x1 = int16_t(clampInt(x + (w > 0 ? w : 0), clip_.x0, clip_.x1));
+        clip_.y1 = int16_t(clampInt(y + (h > 0 ? h : 0), clip_.y0, clip_.y1));
+        return true;
+    }
+    void popClip()
+    {
+        if (clipDepth_)
+            clip_ = clipStack_[--clipDepth_];
+    }
+
+    // Move the origin by (dx,dy): later calls draw at (x+dx, y+dy)
+    bool pushOrigin(int dx, int dy)
+    {
+        if (originDepth_ >= kStackDepth)
+            return false;
+        originStack_[originDepth_][0] = originX_;
+        originStack_[originDepth_][1] = originY_;
+        ++originDepth_;
+        originX_ = int16_t(originX_ + dx);
+        originY_ = int16_t(originY_ + dy);
+        return true;
+    }
+    void popOrigin()
+    {
+        if (!originDepth_)
+            return;
+        --originDepth_;
+        originX_ = originStack_[originDepth_][0];
+        originY_ = originStack_[originDepth_][1];
+    }
+
+    // Current origin in screen pixels
+    int originX() const { return originX_; }
+    int originY() const { return originY_; }
+
+    // Immediate mode control: if true, draw operations present as they go.
+    // Backends may coalesce those presents; leaving immediate mode flushes them.
     virtual void setImmediate(bool on) { immediate = on; }
+    // Present the frame. Backends only push rows written since the last show()
+    // whose contents actually changed, and skip the present for static frames.
     virtual void show() = 0;
 
+    // Rows written since the last show() (candidates for upload).
+    RowMask dirtyRows() const { return dirtyRows_; }
+
+    // While held, immediate-mode draw calls present nothing and written rows
+    // stay dirty. An explicit show() always presents and ends the hold, so a
+    // scene that shows a frame and then blocks is still seen (App holds
+    // presents while a new scene draws its first frame behind a transition).
+    void holdPresents(bool on) { presentsHeld_ = on; }
+    bool presentsHeld() const { return presentsHeld_; }
+
     // Drawing API
     virtual void drawChar(int x, int y, char ch, Color333 c) = 0;
     virtual void drawPixel(int x, int y, Color333 c) = 0;
@@ -58,6 +127,32 @@ public:
     virtual void print(char ch) = 0;
     virtual void print(const char *s) = 0;
     virtual void println(const char *s) = 0;
+    // Draw a string at (x,y) in the current text scale without moving the cursor
+    virtual void drawText(int x, int y, const char *s, Color333 c) = 0;
+
+    // Draw frame `frame` of sprite s with its top-left at (x,y), mirrored by
+    // `flip` (Sprite32::Flip bits). Index 0 is transparent; palette, when
+    // given, replaces s.palette. This version fills each lit run of a row
+    // with fillRect(); RasterMatrix32 writes the runs straight into fb_.
+    virtual void drawSprite(int x, int y, const Sprite32 &s, int frame = 0, uint8_t flip = Sprite32::FlipNone,
+                            const Color333 *palette = nullptr)
+    {
+        if (!palette)
+            palette = s.palette;
+        for (int row = 0; row < s.h; ++row)
+            for (int index = 1; index <= s.colors(); ++index)
+            {
+                uint32_t bits = s.rowMask(frame, row, index, flip);
+                while (bits)
+                {
+                    const int start = __builtin_ctz(bits);
+                    const uint32_t rest = ~(bits >> start);
+                    const int len = rest ? __builtin_ctz(rest) : 32 - start;
+                    fillRect(x + start, y + row, len, 1, palette[index - 1]);
+                    bits &= len < 32 ? ~(((uint32_t(1) << len) - 1) << start) : 0;
+                }
+            }
+    }
 
     /**
      * Build the 5 column bitmasks for a single 5x7 glyph.
@@ -123,14 +218,58 @@ public:
      */
     inline void blitCols(int x0, int y0, const PixelMap *cols, int nCols, Color333 c, int ts)
     {
+        blitColsTo(*this, x0, y0, cols, nCols, c, ts);
+    }
+
+    virtual ~Matrix32() = default;
+
+protected:
+    bool immediate{false}; // if true, show() after each draw operation
+    RowMask dirtyRows_{0}; // rows written since the last show()
+    bool presentsHeld_{false};
+
+    static constexpr RowMask kAllRows = Geometry::kAllRows;
+
+    // Half-open clip rectangle [x0,x1) x [y0,y1) in screen pixels
+    struct ClipRect
+    {
+        int16_t x0, y0, x1, y1;
+    };
+    ClipRect clip_{0, 0, MATRIX_WIDTH, MATRIX_HEIGHT};
+    int16_t originX_{0};
+    int16_t originY_{0};
+    ClipRect clipStack_[kStackDepth];
+    int16_t originStack_[kStackDepth][2];
+    uint8_t clipDepth_{0};
+    uint8_t originDepth_{0};
+
+    // Screen pixel (x,y) lies inside the clip
+    inline bool inClip(int x, int y) const
+    {
+        return clip_.x0 <= x && x < clip_.x1 && clip_.y0 <= y && y < clip_.y1;
+    }
+    static constexpr int clampInt(int v, int lo, int hi) { return v < lo ? lo : (v > hi ? hi : v); }
+
+    // Mark row y as written; y must be on the matrix
+    inline void markRowDirty(int y) { dirtyRows_ |= RowMask(1) << y; }
+    // Mark every row as written (full clears, forced redraws)
+    inline void markAllDirty() { dirtyRows_ = kAllRows; }
+
+    // Body of blitCols(), templated on the target so a backend that knows its
+    // own type (see RasterMatrix32) can reuse it with static fillRect calls.
+    template <class Target>
+    static void blitColsTo(Target &m, int x0, int y0, const PixelMap *cols, int nCols, Color333 c, int ts)
+    {
+        // Visible columns in the caller's coordinates
+        const int left = m.clip_.x0 - m.originX_, right = m.clip_.x1 - m.originX_;
         for (int ci = 0; ci < nCols; ++ci)
         {
             const int x = x0 + ci * ts;
             // Skip columns fully off to the right; break when first fully off-right
-            if (x >= MATRIX_WIDTH)
+            if (x >= right)
                 break;
             // Skip columns fully off to the left
-            if (x + ts <= 0)
+            if (x + ts <= left)
                 continue;
 
             PixelMap bits = cols[ci];
@@ -151,15 +290,10 @@ public:
 
                 // Draw the scaled vertical run as one rectangle
                 const int y = y0 + runStart * ts;
-                fillRect(x, y, ts, runLen * ts, c);
+                m.fillRect(x, y, ts, runLen * ts, c);
             }
         }
     }
-
-    virtual ~Matrix32() = default;
-
-protected:
-    bool immediate{false}; // if true, show() after each draw operation
 };
 
 #endif // MATRIX32_H
@@ -2,6 +2,7 @@
 #include "Helpers.h"
 #include "SceneBus.h"
 #include "Serializer.h"
+#include "Trace.h"
 #include <vector>
 #include <queue>
 
@@ -49,6 +50,8 @@ void MazeScene::renderHints(AppContext &ctx, int8_t textY)
 
 void MazeScene::setStage(AppContext &ctx, Stage newStage)
 {
+    static const char *const kStageNames[] = {"Maze: Intro", "Maze: Game", "Maze: End"};
+    GRID_TRACE_SCOPE(kStageNames[newStage], "stage");
     switch (newStage)
     {
     case Intro:
@@ -59,6 +62,12 @@ void MazeScene::setStage(AppContext &ctx, Stage newStage)
         seen = 0; // set all pixels' flag to unseen
         buildMaze();
         setMazeEndpoints();
+        colorMaze();
+        colorStart();
+        colorFinish();
+        colorSnacks();
+        colorPlayer();
+        redrawGame(ctx.gfx);
         break;
     case End:
         endState_ = ShowBanner;
@@ -109,17 +118,22 @@ void MazeScene::loop(AppContext &ctx)
 
         sampleStrobedDirection(ctx, inputDir, lastUpdateTime);
 
-        if (inputDir != Maze::Direction::None)
-            movePlayer(ctx);
+        {
+            const Maze::matrix_t prevX = playerX, prevY = playerY;
+            if (inputDir != Maze::Direction::None)
+                movePlayer(ctx);
 
-        updateSnacks(now);
+            updateSnacks(now);
 
-        colorMaze();
-        colorStart();
-        colorFinish();
-        colorSnacks();
-        colorPlayer();
-        displayMaze(ctx);
+            // the grid is static apart from the player (and the snack it just ate)
+            if (playerX != prevX || playerY != prevY)
+            {
+                restoreCell(prevX, prevY);
+                colorPlayer();
+                displayMazeAround(ctx.gfx, prevX, prevY);
+                displayMazeAround(ctx.gfx, playerX, playerY);
+            }
+        }
         displayTimer(ctx);
         return;
     case (End):
@@ -227,7 +241,7 @@ void MazeScene::buildAdjacencyGraph(Maze::graph &adj_g)
 Maze::coord MazeScene::getFurthestIndex(Maze::coord src)
 {
     bool visited[maze_g.size];
-    int8_t distance[maze_g.size];
+    int16_t distance[maze_g.size]; // paths can be longer than 127 cells
     for (Maze::coord i = 0; i < maze_g.size; ++i)
     {
         visited[i] = false; // mark all nodes as visited
@@ -262,7 +276,7 @@ Maze::coord MazeScene::getFurthestIndex(Maze::coord src)
         }
     }
 
-    int8_t maxDistance = 0;
+    int16_t maxDistance = 0;
     Maze::coord furthestIdx = src;
     for (Maze::coord i = 0; i < maze_g.size; ++i)
     {
@@ -646,6 +660,16 @@ void MazeScene::colorPlayer()
     grid[playerY][playerX] = HuePalette::Player;
 }
 
+/**
+ * @brief Recolor a cell the player just left (any snack there was eaten)
+ *
+ */
+void MazeScene::restoreCell(Maze::matrix_t x, Maze::matrix_t y)
+{
+    bool isStart = x == Maze::toMatrix(Maze::getX(startNode->pos)) && y == Maze::toMatrix(Maze::getY(startNode->pos));
+    grid[y][x] = isStart ? HuePalette::Start : HuePalette::None;
+}
+
 /**
  * @brief Whether the pixel is part of the border
  *
@@ -673,21 +697,36 @@ bool MazeScene::isNearPlayer(byte x, byte y)
 }
 
 /**
- * @brief Display the maze on the matrix
+ * @brief Draw the whole game frame: the maze (with fog) and, on the next displayTimer(), the timer track
  *
  */
-void MazeScene::displayMaze(AppContext &ctx)
+void MazeScene::redrawGame(GridMatrix &gfx)
+{
+    gfx.clear();
+    displayMaze(gfx, 0, 0, MATRIX_WIDTH - 1, MATRIX_HEIGHT - 1);
+    timerShown_ = kTimerUnset;
+}
+
+/**
+ * @brief Draw the maze cells in [x0..x1] x [y0..y1] (matrix coords)
+ *
+ */
+void MazeScene::displayMaze(GridMatrix &gfx, int x0, int y0, int x1, int y1)
 {
     Color333 color;
     bool near; // whether the pixel is near player or not
     // used for centering
-    Maze::matrix_t rowOffset;
-    Maze::matrix_t colOffset;
-    Maze::matrix_t rows = Maze::toMatrix(Maze::kMazeHeight);
-    Maze::matrix_t cols = Maze::toMatrix(Maze::kMazeWidth);
-    for (Maze::matrix_t r = 0; r < rows; r++)
+    const Maze::matrix_t rows = Maze::toMatrix(Maze::kMazeHeight);
+    const Maze::matrix_t cols = Maze::toMatrix(Maze::kMazeWidth);
+    const Maze::matrix_t rowOffset = (MATRIX_HEIGHT - rows) / 2;
+    const Maze::matrix_t colOffset = (MATRIX_WIDTH - cols) / 2;
+    y0 = std::max(0, y0);
+    x0 = std::max(0, x0);
+    y1 = std::min(int(rows) - 1, y1);
+    x1 = std::min(int(cols) - 1, x1);
+    for (int r = y0; r <= y1; r++)
     {
-        for (Maze::matrix_t c = 0; c < cols; c++)
+        for (int c = x0; c <= x1; c++)
         {
             int i = c + cols * r; // index in flattened array of pixel flags
             near = (isOnMaze(c, r) && isNearPlayer(c, r));
@@ -697,13 +736,20 @@ void MazeScene::displayMaze(AppContext &ctx)
                 color = palette(grid[r][c], near);
             else
                 color = Colors::Black;
-            rowOffset = (MATRIX_HEIGHT - Maze::toMatrix(Maze::kMazeHeight)) / 2;
-            colOffset = (MATRIX_WIDTH - Maze::toMatrix(Maze::kMazeWidth)) / 2;
-            ctx.gfx.drawPixel(c + colOffset, r + rowOffset, color);
+            gfx.set(c + colOffset, r + rowOffset, color);
         }
     }
 }
 
+/**
+ * @brief Redraw the cells whose visibility depends on a player at (x,y)
+ *
+ */
+void MazeScene::displayMazeAround(GridMatrix &gfx, Maze::matrix_t x, Maze::matrix_t y)
+{
+    displayMaze(gfx, x - kVisibility, y - kVisibility, x + kVisibility, y + kVisibility);
+}
+
 /**
  * @brief Display the time left in the game
  *
@@ -719,6 +765,9 @@ void MazeScene::displayTimer(AppContext &ctx)
         setStage(ctx, End);
         return;
     }
+    if (pixelsPassed == timerShown_)
+        return;
+    timerShown_ = pixelsPassed;
 
     // draw time track
     for (TimerCount_t i = 1; i <= kTimerPixels; i++)
@@ -734,12 +783,7 @@ void MazeScene::displayTimer(AppContext &ctx)
             c = MATRIX_WIDTH - (i - MATRIX_HEIGHT);
         }
 
-        if (i <= pixelsPassed)
-            grid[r - 1][c - 1] = HuePalette::None;
-        else
-            grid[r - 1][c - 1] = HuePalette::Time;
-
-        ctx.gfx.drawPixel(c - 1, r - 1, palette(grid[r - 1][c - 1]));
+        ctx.gfx.set(c - 1, r - 1, i <= pixelsPassed ? Colors::Black : palette(HuePalette::Time));
     }
 }
 
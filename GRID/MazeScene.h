@@ -7,16 +7,19 @@
 #include "ScoreData.h"
 #include <climits>
 #include <bitset>
+#include <type_traits>
 
 struct Maze
 {
-    // Maze Config
-    static constexpr uint8_t kMazeWidth = 15;
-    static constexpr uint8_t kMazeHeight = 15;
+    // Maze Config: cells are two pixels apart with walls between them; the
+    // panel's last column and row are left for the timer track
+    static constexpr uint8_t kMazeWidth = (MATRIX_WIDTH - 1) / 2;   // 15 on a 32x32 panel
+    static constexpr uint8_t kMazeHeight = (MATRIX_HEIGHT - 1) / 2; // 15 on a 32x32 panel
     static constexpr uint8_t kMaxNeighbors = 4;
-    static constexpr uint8_t kMaxEdges = (kMazeWidth * kMazeHeight) - 1;
+    static constexpr uint16_t kMaxEdges = (kMazeWidth * kMazeHeight) - 1;
 
-    using coord = uint8_t;                   // used for compressed position
+    // used for compressed position (a byte up to a 32x32 panel; None must stay out of range)
+    using coord = std::conditional<(kMazeWidth * kMazeHeight < UINT8_MAX), uint8_t, uint16_t>::type;
     using coords = std::vector<Maze::coord>; // list of compressed positions
     using matrix_t = uint8_t;                // positions in Matrix-space
     using maze_t = uint8_t;                  // positions in Maze-space
@@ -140,7 +143,7 @@ struct Maze
     class graph
     {
     public:
-        static constexpr uint8_t size = kMazeWidth * kMazeHeight; // number of vertices
+        static constexpr uint16_t size = kMazeWidth * kMazeHeight; // number of vertices
         node vertices[size];                                      // array of graph vertices
 
         graph() {}
@@ -172,7 +175,7 @@ struct Maze
         }
     };
 
-    static constexpr int16_t kMazePixels = 961; // 31 * 31
+    static constexpr int16_t kMazePixels = (2 * kMazeWidth + 1) * (2 * kMazeHeight + 1); // 961 on a 32x32 panel
 };
 
 class MazeScene : public Scene
@@ -222,7 +225,7 @@ private:
     Maze::node *endNode = nullptr;
     Maze::matrix_t playerX, playerY;
     Maze::coords snacks;
-    std::bitset<Maze::kMazePixels> seen; // saves memory: 961 bits ~120 bytes instead of 961 bytes
+    std::bitset<Maze::kMazePixels> seen; // saves memory: 961 bits ~120 bytes instead of 961 bytes (32x32)
 
     // Generation
 
@@ -252,14 +255,14 @@ private:
 
     // Timer
 
-    static constexpr uint8_t kTimerPixels = 63;                    // how many pixels used for timer
+    static constexpr uint8_t kTimerPixels = MATRIX_WIDTH + MATRIX_HEIGHT - 1; // right column + bottom row
     static constexpr millis_t kGameDefaultDuration = (180 * 1000); // start with 3 mins to finish the game
 
     // Drawing
 
     static constexpr Colors::HSV::val_t kNearBrightness = 100; // 3/7 brightness
     static constexpr Colors::HSV::val_t kFarBrightness = 37;   // 1/7 on the brightness scale
-    enum HuePalette : Colors::HSV::hue_t
+    enum HuePalette : uint8_t // one byte per grid cell: grid costs 1 KB, not 2
     {
         None,
         Wall,
@@ -270,6 +273,12 @@ private:
         Food
     };
     HuePalette grid[MATRIX_HEIGHT][MATRIX_WIDTH]; // color of each pixel in matrix
+    // Game stage frame: drawn straight from grid (no offscreen layers, which
+    // would cost 2 KB each on the board). Only the cells around the player's
+    // old and new position are redrawn, and the timer track when it changes;
+    // the maze fills the top-left and never overlaps the track.
+    static constexpr uint8_t kTimerUnset = UINT8_MAX;
+    uint8_t timerShown_ = kTimerUnset; // timer pixels passed as last drawn
     /**
      * @brief returns a color from the given hue and whether it should be the brighter variant
      */
@@ -305,7 +314,10 @@ private:
     bool isBorder(Maze::matrix_t r, Maze::matrix_t col);
     bool isNearPlayer(Maze::matrix_t x, Maze::matrix_t y);
     bool isOnMaze(Maze::matrix_t x, Maze::matrix_t y);
-    void displayMaze(AppContext &ctx);
+    void restoreCell(Maze::matrix_t x, Maze::matrix_t y);
+    void displayMaze(GridMatrix &gfx, int x0, int y0, int x1, int y1);
+    void displayMazeAround(GridMatrix &gfx, Maze::matrix_t x, Maze::matrix_t y);
+    void redrawGame(GridMatrix &gfx);
     void displayTimer(AppContext &ctx);
     bool playerHasFinished();
 
@@ -343,6 +355,11 @@ private:
 public:
     void setup(AppContext &ctx) override;
     void loop(AppContext &ctx) override;
+    void resume(AppContext &ctx) override
+    {
+        if (stage == Game)
+            redrawGame(ctx.gfx);
+    }
 
     SceneKind kind() const override { return SceneKind::Maze; }
     const char *label() const override { return "Maze"; }
@@ -1,4 +1,5 @@
 #include "MenuScene.h"
+#include <new>
 
 // Define the static item array (labels + pointer-to-member in SceneBus)
 const std::array<MenuScene::MenuItem, 6> MenuScene::kItems = {
@@ -9,6 +10,11 @@ const std::array<MenuScene::MenuItem, 6> MenuScene::kItems = {
     MenuScene::MenuItem{"Calib", &SceneBus::toCalibration},
     MenuScene::MenuItem{"QR", &SceneBus::toQR}};
 
+void MenuScene::setup(AppContext &ctx)
+{
+    list_.reset(new (std::nothrow) DisplayListMatrix32(ctx.gfx));
+}
+
 void MenuScene::loop(AppContext &ctx)
 {
     const InputState s = ctx.input.state();
@@ -64,30 +70,42 @@ void MenuScene::prev()
 
 void MenuScene::draw(AppContext &ctx, bool left, bool right, bool press)
 {
-    ctx.gfx.clear();
-    ctx.gfx.setTextSize(1);
-    ctx.gfx.setCursor(1, 1);
-    ctx.gfx.setTextColor(Colors::Muted::White);
+    if (list_)
+    {
+        drawTo(*list_, left, right, press);
+        list_->flush();
+    }
+    else
+        drawTo(ctx.gfx, left, right, press);
+}
+
+template <class Matrix>
+void MenuScene::drawTo(Matrix &gfx, bool left, bool right, bool press)
+{
+    gfx.clear();
+    gfx.setTextSize(1);
+    gfx.setCursor(1, 1);
+    gfx.setTextColor(Colors::Muted::White);
 
-    ctx.gfx.print("Menu:");
-    ctx.gfx.setCursor(1, 12);
+    gfx.print("Menu:");
+    gfx.setCursor(1, 12);
     if (press)
-        ctx.gfx.setTextColor(Colors::Bright::Green);
+        gfx.setTextColor(Colors::Bright::Green);
     else
-        ctx.gfx.setTextColor(Colors::Muted::White);
+        gfx.setTextColor(Colors::Muted::White);
 
-    ctx.gfx.println(kItems[selected].label);
+    gfx.println(kItems[selected].label);
 
     // arrow hint
-    ctx.gfx.setCursor(1, MATRIX_HEIGHT - 8);
-    ctx.gfx.setTextColor(left ? Colors::Bright::White : Colors::Muted::White);
-    ctx.gfx.print("<");
+    gfx.setCursor(1, MATRIX_HEIGHT - 8);
+    gfx.setTextColor(left ? Colors::Bright::White : Colors::Muted::White);
+    gfx.print("<");
 
-    ctx.gfx.setCursor(10, MATRIX_HEIGHT - 8);
-    ctx.gfx.setTextColor(press ? Colors::Bright::White : Colors::Muted::White);
-    ctx.gfx.print("OK");
+    gfx.setCursor(10, MATRIX_HEIGHT - 8);
+    gfx.setTextColor(press ? Colors::Bright::White : Colors::Muted::White);
+    gfx.print("OK");
 
-    ctx.gfx.setCursor(MATRIX_WIDTH - 6, MATRIX_HEIGHT - 8);
-    ctx.gfx.setTextColor(right ? Colors::Bright::White : Colors::Muted::White);
-    ctx.gfx.print(">");
+    gfx.setCursor(MATRIX_WIDTH - 6, MATRIX_HEIGHT - 8);
+    gfx.setTextColor(right ? Colors::Bright::White : Colors::Muted::White);
+    gfx.print(">");
 }
@@ -1,8 +1,10 @@
 #ifndef MENU_SCENE_H
 #define MENU_SCENE_H
+#include "DisplayListMatrix32.h"
 #include "Scene.h"
 #include "SceneBus.h"
 #include <array>
+#include <memory>
 
 struct MenuScene : public Scene
 {
@@ -25,7 +27,7 @@ struct MenuScene : public Scene
         return SceneTimingPrefs(std::numeric_limits<double>::quiet_NaN());
     }
 
-    void setup(AppContext &ctx) override {} // no-op
+    void setup(AppContext &ctx) override;
 
     void loop(AppContext &ctx) override;
 
@@ -41,6 +43,13 @@ private:
     void next();
     void prev();
     void draw(AppContext &ctx, bool left, bool right, bool press);
+    template <class Matrix>
+    void drawTo(Matrix &gfx, bool left, bool right, bool press);
+
+    // The menu is redrawn from scratch every frame; recording it lets
+    // unchanged frames skip rasterizing altogether. Null if the 1 KB list
+    // could not be allocated: the menu then draws straight to the matrix.
+    std::unique_ptr<DisplayListMatrix32> list_;
     // removed label(const Item) - use kItems[selected].label instead
 };
 
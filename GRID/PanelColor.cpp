@@ -0,0 +1,15 @@
+#include "PanelColor.h"
+
+// Expanded with macros rather than a constexpr loop so the table stays
+// constant-initialized under the C++11 Arduino toolchain.
+#define PANEL_LUT4(i) panelColor333(i), panelColor333(i + 1), panelColor333(i + 2), panelColor333(i + 3)
+#define PANEL_LUT16(i) PANEL_LUT4(i), PANEL_LUT4(i + 4), PANEL_LUT4(i + 8), PANEL_LUT4(i + 12)
+#define PANEL_LUT64(i) PANEL_LUT16(i), PANEL_LUT16(i + 16), PANEL_LUT16(i + 32), PANEL_LUT16(i + 48)
+#define PANEL_LUT256(i) PANEL_LUT64(i), PANEL_LUT64(i + 64), PANEL_LUT64(i + 128), PANEL_LUT64(i + 192)
+
+const PanelColor kPanelColorLut[COLOR333_COUNT] = {PANEL_LUT256(0), PANEL_LUT256(256)};
+
+#undef PANEL_LUT256
+#undef PANEL_LUT64
+#undef PANEL_LUT16
+#undef PANEL_LUT4
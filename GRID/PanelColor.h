@@ -0,0 +1,30 @@
+#ifndef PANEL_COLOR_H
+#define PANEL_COLOR_H
+
+#include "Colors.h"
+#include <cstdint>
+
+using PanelColor = uint16_t;
+
+// Same packing as RGBmatrixPanel::Color333(): 3-3-3 promoted to 5-6-5 (RRRrrGGGgggBBBbb).
+// Takes the packed 9-bit code so the table below can be generated at compile time.
+constexpr PanelColor panelColor333(uint16_t i)
+{
+    return static_cast<PanelColor>((((i >> 6) & 0x7) << 13) | (((i >> 6) & 0x6) << 10) |
+                                   (((i >> 3) & 0x7) << 8) | (((i >> 3) & 0x7) << 5) |
+                                   ((i & 0x7) << 2) | ((i & 0x6) >> 1));
+}
+
+// PanelColor -> packed Color333 code: the inverse of panelColor333 (drops the promoted low bits)
+constexpr uint16_t panelColorCode(PanelColor p)
+{
+    return static_cast<uint16_t>((((p >> 13) & 0x7) << 6) | (((p >> 8) & 0x7) << 3) | ((p >> 2) & 0x7));
+}
+
+// All 512 Color333 values in panel format; const data, so it lives in flash on the board
+extern const PanelColor kPanelColorLut[COLOR333_COUNT];
+
+// Color333 -> PanelColor: one table load per pixel
+inline PanelColor toPanelColor(Color333 c) { return kPanelColorLut[packColor333(c)]; }
+
+#endif // PANEL_COLOR_H
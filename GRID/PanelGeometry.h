@@ -0,0 +1,41 @@
+#ifndef PANEL_GEOMETRY_H
+#define PANEL_GEOMETRY_H
+
+#include <cstdint>
+#include <type_traits>
+
+// Panel geometry, fixed at compile time.
+//
+// One 32x32 panel by default. Build with GRID_PANEL_WIDTH / GRID_PANEL_HEIGHT
+// to target chained panels, e.g. -DGRID_PANEL_WIDTH=64 for two 32x32 panels
+// side by side or both at 64 for a 64x64 panel (`make PANEL_WIDTH=64
+// PANEL_HEIGHT=64` on the desktop). Code reads the size through MATRIX_WIDTH
+// and MATRIX_HEIGHT (Matrix32.h); they stay compile-time constants, so the
+// per-pixel index math still folds to shifts and adds.
+#ifndef GRID_PANEL_WIDTH
+#define GRID_PANEL_WIDTH 32
+#endif
+#ifndef GRID_PANEL_HEIGHT
+#define GRID_PANEL_HEIGHT 32
+#endif
+
+template <int Width, int Height>
+struct PanelGeometry
+{
+    // Rows are processed in 8-pixel lanes (PostFX32) and coordinates fit a byte
+    static_assert(Width >= 8 && Width <= 128 && Width % 8 == 0, "panel width must be a multiple of 8, at most 128");
+    static_assert(Height >= 8 && Height <= 64, "panel height must be 8..64 (one dirty bit per row)");
+
+    static constexpr int kWidth = Width;
+    static constexpr int kHeight = Height;
+    static constexpr int kPixels = Width * Height;
+
+    // One bit per row (bit y = row y)
+    using RowMask = typename std::conditional<(Height <= 32), uint32_t, uint64_t>::type;
+    static constexpr RowMask kAllRows =
+        Height == int(sizeof(RowMask) * 8) ? ~RowMask(0) : ((RowMask(1) << (Height % (sizeof(RowMask) * 8))) - 1);
+};
+
+using Geometry = PanelGeometry<GRID_PANEL_WIDTH, GRID_PANEL_HEIGHT>;
+
+#endif // PANEL_GEOMETRY_H
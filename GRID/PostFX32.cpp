@@ -0,0 +1,152 @@
+#include "PostFX32.h"
+#include <cstring>
+
+#if defined(GRID_EMULATION) && defined(__GNUC__)
+#define GRID_POSTFX_SIMD 1
+#else
+#define GRID_POSTFX_SIMD 0
+#endif
+
+namespace
+{
+// Vertical 3-tap sums of one channel over a padded row, then horizontal
+// 3-tap sums rounded to /9: ((sum + 4) * 57) >> 9 == round(sum / 9) for
+// the 0..63 range a 3x3 window of 3-bit channels can reach.
+constexpr int kLanes = 8;
+constexpr int kChunks = PostFX32::kRowPad / kLanes;
+
+inline uint16_t boxAvg(uint16_t sum) { return uint16_t(((sum + 4) * 57) >> 9); }
+
+inline uint16_t maxChannel(uint16_t code)
+{
+    const uint16_t r = code >> 6, g = (code >> 3) & 7, b = code & 7;
+    const uint16_t m = r > g ? r : g;
+    return m > b ? m : b;
+}
+
+// Box average of channel `shift` for the MATRIX_WIDTH pixels of the middle row
+void boxRowScalar(const uint16_t *const rows[3], int shift, uint16_t *avg)
+{
+    uint16_t vs[PostFX32::kRowPad];
+    for (int i = 0; i < PostFX32::kRowPad; ++i)
+        vs[i] = uint16_t(((rows[0][i] >> shift) & 7) + ((rows[1][i] >> shift) & 7) + ((rows[2][i] >> shift) & 7));
+    for (int x = 0; x < MATRIX_WIDTH; ++x)
+        avg[x] = boxAvg(uint16_t(vs[x] + vs[x + 1] + vs[x + 2]));
+}
+
+void decayRowScalar(uint16_t *codes, int n, uint16_t keep)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        const uint16_t c = codes[i];
+        codes[i] = uint16_t((((c >> 6) * keep) >> 8) << 6 |
+                            ((((c >> 3) & 7) * keep) >> 8) << 3 |
+                            (((c & 7) * keep) >> 8));
+    }
+}
+
+#if GRID_POSTFX_SIMD
+typedef uint16_t V8 __attribute__((vector_size(16)));
+
+inline V8 load8(const uint16_t *p)
+{
+    V8 v;
+    memcpy(&v, p, sizeof v);
+    return v;
+}
+
+inline void store8(uint16_t *p, V8 v) { memcpy(p, &v, sizeof v); }
+
+void boxRowSimd(const uint16_t *const rows[3], int shift, uint16_t *avg)
+{
+    uint16_t vs[PostFX32::kRowPad + kLanes]; // tail read by the +1/+2 loads
+    const V8 seven = V8{} + 7;
+    for (int c = 0; c < kChunks; ++c)
+    {
+        const int i = c * kLanes;
+        store8(vs + i, ((load8(rows[0] + i) >> shift) & seven) +
+                           ((load8(rows[1] + i) >> shift) & seven) +
+                           ((load8(rows[2] + i) >> shift) & seven));
+    }
+    memset(vs + PostFX32::kRowPad, 0, sizeof(uint16_t) * kLanes);
+    for (int x = 0; x < MATRIX_WIDTH; x += kLanes)
+    {
+        const V8 sum = load8(vs + x) + load8(vs + x + 1) + load8(vs + x + 2);
+        store8(avg + x, ((sum + 4) * 57) >> 9);
+    }
+}
+
+void decayRowSimd(uint16_t *codes, int n, uint16_t keep)
+{
+    const V8 seven = V8{} + 7;
+    const V8 k = V8{} + keep;
+    int i = 0;
+    for (; i + kLanes <= n; i += kLanes)
+    {
+        const V8 c = load8(codes + i);
+        store8(codes + i, ((((c >> 6) * k) >> 8) << 6) |
+                              (((((c >> 3) & seven) * k) >> 8) << 3) |
+                              (((c & seven) * k) >> 8));
+    }
+    decayRowScalar(codes + i, n - i, keep);
+}
+#endif
+} // namespace
+
+PostFX32::Path PostFX32::defaultPath()
+{
+    return GRID_POSTFX_SIMD ? Path::Simd : Path::Scalar;
+}
+
+void PostFX32::decayRow(uint16_t *codes, int n, uint16_t keep, Path path)
+{
+#if GRID_POSTFX_SIMD
+    if (path == Path::Simd)
+    {
+        decayRowSimd(codes, n, keep);
+        return;
+    }
+#else
+    (void)path;
+#endif
+    decayRowScalar(codes, n, keep);
+}
+
+void PostFX32::brightRow(const uint16_t *row, uint16_t *out) const
+{
+    for (int i = 0; i < kRowPad; ++i)
+        out[i] = maxChannel(row[i]) >= glowThreshold ? row[i] : 0;
+}
+
+void PostFX32::filterRow(const uint16_t *const rows[3], const uint16_t *const bright[3], uint16_t *out, Path path) const
+{
+    void (*box)(const uint16_t *const[3], int, uint16_t *) = boxRowScalar;
+#if GRID_POSTFX_SIMD
+    if (path == Path::Simd)
+        box = boxRowSimd;
+#else
+    (void)path;
+#endif
+    uint16_t ch[MATRIX_WIDTH], glow[MATRIX_WIDTH];
+    for (int x = 0; x < MATRIX_WIDTH; ++x)
+        out[x] = 0;
+    for (int shift = 6; shift >= 0; shift -= 3)
+    {
+        if (blur)
+            box(rows, shift, ch);
+        else
+            for (int x = 0; x < MATRIX_WIDTH; ++x)
+                ch[x] = (rows[1][x + 1] >> shift) & 7;
+        if (glowThreshold)
+        {
+            box(bright, shift, glow);
+            for (int x = 0; x < MATRIX_WIDTH; ++x)
+            {
+                const uint16_t v = uint16_t(ch[x] + ((glow[x] * glowGain) >> 8));
+                ch[x] = v > 7 ? 7 : v;
+            }
+        }
+        for (int x = 0; x < MATRIX_WIDTH; ++x)
+            out[x] = uint16_t(out[x] | ch[x] << shift);
+    }
+}
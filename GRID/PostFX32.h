@@ -0,0 +1,131 @@
+#ifndef POSTFX32_H
+#define POSTFX32_H
+
+#include "Colors.h"
+#include "Matrix32.h"
+#include <cstdint>
+
+// Integer post-processing on a backend framebuffer, in place.
+//
+// Everything works on packed Color333 codes read back through the backend's
+// codeAt(i), so the emulator shows exactly what the panel will. Only pixels
+// that change are written back with set(), so a frame that has settled stays
+// clean and show() still skips it. Nothing allocates: the filters keep a
+// three-row window (about 700 bytes at 32 wide) on the stack.
+//
+//   decay  per-channel fade, v * decayKeep / 256 (rounded down). App runs it
+//          on the previous frame before Scene::loop(), so what the scene
+//          draws this frame shows at full color and older pixels leave
+//          trails instead of being cleared.
+//   blur   3x3 box blur (edges replicated), rounded.
+//   glow   3x3 blur of the pixels whose brightest channel is at least
+//          glowThreshold, added back at glowGain / 256 (up to 512),
+//          saturating.
+// filter() (blur, then glow) runs between Scene::loop() and show().
+//
+// The row kernels have a scalar path (the reference; used on the board) and
+// a SIMD path built with compiler vector extensions on the emulator. The two
+// produce identical codes; grid-microbench checks that and times both.
+struct PostFX32
+{
+    static constexpr uint16_t kKeepAll = 256; // decayKeep that leaves pixels unchanged
+
+    uint16_t decayKeep{kKeepAll}; // 0..256
+    bool blur{false};
+    uint8_t glowThreshold{0}; // 1..7 enables glow
+    uint16_t glowGain{256};   // 256 adds the glow at full strength
+
+    bool decays() const { return decayKeep < kKeepAll; }
+    bool filters() const { return blur || glowThreshold; }
+
+    enum class Path : uint8_t
+    {
+        Scalar,
+        Simd
+    };
+    // Path used by decay()/filter() in this build
+    static Path defaultPath();
+
+    // Padded row: [0] and [MATRIX_WIDTH + 1] replicate the edge pixels,
+    // [1..MATRIX_WIDTH] are the row, the rest rounds up to whole 8-pixel lanes
+    static constexpr int kRowPad = MATRIX_WIDTH + 8;
+    using Row = uint16_t[kRowPad];
+
+    // Row kernels (exposed for the microbenchmarks)
+    static void decayRow(uint16_t *codes, int n, uint16_t keep, Path path);
+    // out[x] for the middle row of the window; rows are padded, bright rows
+    // hold the glow pass (unused when glow is off)
+    void filterRow(const uint16_t *const rows[3], const uint16_t *const bright[3], uint16_t *out, Path path) const;
+    // Bright-pass of a padded row for glow
+    void brightRow(const uint16_t *row, uint16_t *out) const;
+
+    // Fade every pixel of gfx (a backend with codeAt(i) and set())
+    template <class Target>
+    void decay(Target &gfx, Path path = defaultPath()) const
+    {
+        if (!decays())
+            return;
+        uint16_t row[MATRIX_WIDTH], out[MATRIX_WIDTH];
+        for (int y = 0; y < MATRIX_HEIGHT; ++y)
+        {
+            for (int x = 0; x < MATRIX_WIDTH; ++x)
+                row[x] = out[x] = gfx.codeAt(y * MATRIX_WIDTH + x);
+            decayRow(out, MATRIX_WIDTH, decayKeep, path);
+            store(gfx, y, row, out);
+        }
+    }
+
+    // Blur and/or glow gfx in place
+    template <class Target>
+    void filter(Target &gfx, Path path = defaultPath()) const
+    {
+        if (!filters())
+            return;
+        // Rolling window of original rows y-1, y, y+1 (edges replicated)
+        Row orig[3], bright[3];
+        uint16_t out[MATRIX_WIDTH];
+        load(gfx, 0, orig[1], bright[1]);
+        load(gfx, 0, orig[0], bright[0]);
+        load(gfx, 1, orig[2], bright[2]);
+        int top = 0; // orig[top] is row y-1
+        for (int y = 0; y < MATRIX_HEIGHT; ++y)
+        {
+            const int mid = (top + 1) % 3, bot = (top + 2) % 3;
+            const uint16_t *rows[3] = {orig[top], orig[mid], orig[bot]};
+            const uint16_t *brights[3] = {bright[top], bright[mid], bright[bot]};
+            filterRow(rows, brights, out, path);
+            store(gfx, y, orig[mid] + 1, out);
+            // Slide: the old top row becomes row y+2 (clamped at the bottom)
+            if (y + 1 < MATRIX_HEIGHT)
+            {
+                load(gfx, y + 2 < MATRIX_HEIGHT ? y + 2 : MATRIX_HEIGHT - 1, orig[top], bright[top]);
+                top = mid;
+            }
+        }
+    }
+
+private:
+    template <class Target>
+    void load(Target &gfx, int y, uint16_t *row, uint16_t *bright) const
+    {
+        for (int x = 0; x < MATRIX_WIDTH; ++x)
+            row[x + 1] = gfx.codeAt(y * MATRIX_WIDTH + x);
+        row[0] = row[1];
+        row[MATRIX_WIDTH + 1] = row[MATRIX_WIDTH];
+        for (int x = MATRIX_WIDTH + 2; x < kRowPad; ++x)
+            row[x] = 0;
+        if (glowThreshold)
+            brightRow(row, bright);
+    }
+
+    // Write back only the pixels that changed
+    template <class Target>
+    static void store(Target &gfx, int y, const uint16_t *before, const uint16_t *after)
+    {
+        for (int x = 0; x < MATRIX_WIDTH; ++x)
+            if (after[x] != before[x])
+                gfx.set(x, y, unpackColor333(after[x]));
+    }
+};
+
+#endif // POSTFX32_H
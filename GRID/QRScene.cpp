@@ -1,54 +1,24 @@
 #include "QRScene.h"
+#include "Assets.h"
 #include "Colors.h"
 #include "Logging.h"
 
-const uint8_t qr25x25[25][25] = {
-    {1,1,1,1,1,1,1,0,1,0,0,1,1,1,1,0,0,0,1,1,1,1,1,1,1},
-    {1,0,0,0,0,0,1,0,0,1,1,0,0,0,0,0,0,0,1,0,0,0,0,0,1},
-    {1,0,1,1,1,0,1,0,0,0,1,0,1,1,1,0,0,0,1,0,1,1,1,0,1},
-    {1,0,1,1,1,0,1,0,0,0,0,0,1,1,0,1,1,0,1,0,1,1,1,0,1},
-    {1,0,1,1,1,0,1,0,0,1,0,1,0,1,1,0,0,0,1,0,1,1,1,0,1},
-    {1,0,0,0,0,0,1,0,0,0,1,0,1,0,0,0,0,0,1,0,0,0,0,0,1},
-    {1,1,1,1,1,1,1,0,1,0,1,0,1,0,1,0,1,0,1,1,1,1,1,1,1},
-    {0,0,0,0,0,0,0,0,1,0,1,1,0,1,0,0,1,0,0,0,0,0,0,0,0},
-    {1,1,0,1,1,0,1,0,0,1,1,1,1,0,1,1,0,0,1,0,0,0,0,0,1},
-    {0,1,0,0,0,0,0,1,0,1,0,0,1,0,0,1,0,1,0,1,1,1,1,1,0},
-    {0,1,1,1,1,1,1,1,0,0,1,1,0,0,0,1,1,1,1,0,0,1,0,0,1},
-    {0,1,1,1,1,1,0,0,0,1,1,0,0,0,0,0,0,1,0,0,0,1,1,1,1},
-    {1,1,0,0,1,1,1,0,1,1,0,0,1,0,0,1,0,0,1,1,0,0,0,0,1},
-    {1,0,0,1,1,1,0,1,0,0,0,1,1,0,1,1,1,1,0,0,1,0,0,1,0},
-    {1,1,0,0,0,1,1,0,1,1,0,0,0,1,0,1,1,0,0,0,1,1,1,1,1},
-    {1,0,0,0,1,0,0,1,1,1,0,1,0,0,1,0,0,1,1,1,0,1,1,0,1},
-    {1,0,0,1,1,1,1,1,0,1,1,0,1,1,0,0,1,1,1,1,1,0,1,1,0},
-    {0,0,0,0,0,0,0,0,1,1,1,0,0,0,1,0,1,0,0,0,1,0,1,1,0},
-    {1,1,1,1,1,1,1,0,0,0,0,1,0,1,0,0,1,0,1,0,1,0,0,0,1},
-    {1,0,0,0,0,0,1,0,0,1,0,0,1,1,0,1,1,0,0,0,1,0,0,1,0},
-    {1,0,1,1,1,0,1,0,1,0,1,1,1,0,1,1,1,1,1,1,1,0,0,0,0},
-    {1,0,1,1,1,0,1,0,1,0,0,1,0,0,1,0,0,1,1,0,0,0,0,1,1},
-    {1,0,1,1,1,0,1,0,0,1,0,1,1,1,1,0,1,1,0,0,1,1,1,1,1},
-    {1,0,0,0,0,0,1,0,1,0,0,0,0,0,0,0,0,1,1,1,1,0,1,1,1},
-    {1,1,1,1,1,1,1,0,1,1,1,0,1,0,1,0,1,0,1,0,0,1,0,0,1}
-};
-
 void QRScene::setup(AppContext &ctx)
 {
     const char *url = "https://bryanluu.github.io/";
 
-    const int size = 25; // fixed size for this QR code
+    const Sprite32 &qr = Assets::kQRCode; // assets/qr.txt
+    const int size = qr.w;
     ctx.logger.logf(LogLevel::Info, "QR size: %d x %d", size, size);
 
     // used for centering the QR
     const int kXOffset = (MATRIX_WIDTH - size) / 2;
     const int kYOffset = (MATRIX_HEIGHT - size) / 2;
 
-    for (int y = 0; y < size; y++)
-    {
-        for (int x = 0; x < size; x++)
-        {
-            bool black = qr25x25[y][x] == 1;
-            ctx.gfx.setSafe(x + kXOffset, y + kYOffset, black ? Colors::Black : Colors::Muted::White);
-        }
-    }
+    // Light modules are lit; dark ones stay the cleared background
+    ctx.gfx.pushOrigin(kXOffset, kYOffset);
+    ctx.gfx.drawSprite(0, 0, qr);
+    ctx.gfx.popOrigin();
 }
 
 void QRScene::loop(AppContext &ctx)
@@ -1,76 +1,79 @@
 #ifndef RGB_MATRIX_H
 #define RGB_MATRIX_H
 
-#include "Matrix32.h"
+#include "PanelColor.h"
+#include "RasterMatrix32.h"
 #include <RGBmatrixPanel.h>
 
-using PanelColor = uint16_t;
+// Build with GRID_INDEXED_FB=4 or 8 to keep a palette-indexed framebuffer
+// (IndexedPixels) instead of one PanelColor per pixel; indices are resolved to
+// panel colors row by row in show(). Saves ~1.5 KB (4-bit) or ~0.5 KB (8-bit)
+// of the Metro M0's 32 KB RAM, at the cost of palette limits (see IndexedPixels.h).
+#if defined(GRID_INDEXED_FB)
+#include "IndexedPixels.h"
+#endif
+
+// The 32-row RGBmatrixPanel constructor drives address lines A..D only, so
+// the device build supports chains of 32-row panels (GRID_PANEL_WIDTH 64, ...)
+// but not 64-row panels, which need the E line.
+static_assert(MATRIX_HEIGHT == 32, "RGBMatrix32 drives 32-row panels (no E address line)");
 
 // Adapter that wraps an existing Adafruit RGBmatrixPanel
-class RGBMatrix32 : public Matrix32
+class RGBMatrix32 final : public RasterMatrix32<RGBMatrix32>
 {
-
     RGBmatrixPanel &m; // reference to a live panel
 
-    // Text state
-    int cx{0};                      // cursor x in pixels
-    int cy{0};                      // cursor y in pixels
-    int lineStartX{0};              // start-of-line x for newline handling
-    int ts{1};                      // text scale
-    Color333 tc{Color333{7, 7, 7}}; // text color
-
-    // Low-level framebuffer helpers
-
-    void span(int x0, int x1, int y, Color333 c);
-    void drawHLine(int x, int y, int w, Color333 c);
-    void drawVLine(int x, int y, int h, Color333 c);
-    void plot8(int cx, int cy, int x, int y, Color333 c);
-    void drawPixelScaled(int x, int y, Color333 c);
+    bool fullRedraw_{true}; // next show() must push every row
 
 public:
     // Panel must outlive this adapter
     explicit RGBMatrix32(RGBmatrixPanel &panel) : m(panel) {}
 
-    // 32x32 RGB framebuffer (row-major)
-    PanelColor fb_[MATRIX_WIDTH * MATRIX_HEIGHT]{};
     // Convert (x,y) to framebuffer index.
     static constexpr int coordToIndex(int x, int y)
     {
         return y * MATRIX_WIDTH + x;
     }
+
+#if defined(GRID_INDEXED_FB)
+    using Pixels = IndexedPixels<GRID_INDEXED_FB>;
+    // Palette indices (row-major) plus the frame's palette
+    Pixels fb_;
+    PanelColor get(int x, int y) const { return kPanelColorLut[fb_.codeAt(coordToIndex(x, y))]; }
+    // Packed Color333 of pixel i (frame readback, see Canvas32::capture)
+    uint16_t codeAt(int i) const { return fb_.codeAt(i); }
+    // Palette slot for a Color333 (allocated on first use)
+    Pixels::Index convertColor(Color333 c) { return fb_.indexOf(c); }
+    // Preload the frame palette, e.g. from a scene's setup()
+    void setPalette(const Color333 *colors, int n) { fb_.setPalette(colors, n); }
+
+    // Storage hooks for RasterMatrix32: indices may be packed two per byte
+    void storePixel(int i, Pixels::Index px) { fb_.store(i, px); }
+    void fillPixels(int i, int n, Pixels::Index px) { fb_.fill(i, n, px); }
+    void fillFrame(Color333 c) { fb_.fillFrame(c); }
+#else
+    // 32x32 RGB framebuffer (row-major)
+    PanelColor fb_[MATRIX_WIDTH * MATRIX_HEIGHT]{};
     PanelColor get(int x, int y) const { return fb_[coordToIndex(x, y)]; }
-    // Converts a Color333 to the type used by the panel
-    PanelColor convertColor(Color333 c)
-    {
-        return m.Color333(c.r, c.g, c.b);
-    }
+    // Packed Color333 of pixel i (frame readback, see Canvas32::capture)
+    uint16_t codeAt(int i) const { return panelColorCode(fb_[i]); }
+    // Converts a Color333 to the type used by the panel (flash table, same result as m.Color333())
+    PanelColor convertColor(Color333 c) const { return toPanelColor(c); }
+#endif
 
     // Matrix32 interface
 
     void begin() override;
-    void clear() override;
-    void set(int x, int y, Color333 c) override;
+    void set(int x, int y, Color333 c) override
+    {
+        writePixel(x, y, c);
+        markRowDirty(y);
+    }
+    // Wall-clock milliseconds for the immediate-mode throttle
+    millis_t wallMs() const { return millis(); }
     void show() override;
 
-    // Drawing API (1:1 to Adafruit panel)
-
-    void drawPixel(int x, int y, Color333 c) override;
-    void drawLine(int x0, int y0, int x1, int y1, Color333 c) override;
-    void drawRect(int x, int y, int w, int h, Color333 c) override;
-    void drawCircle(int cx, int cy, int r, Color333 c) override;
-    void fillRect(int x, int y, int w, int h, Color333 c) override;
-    void fillCircle(int cx, int cy, int r, Color333 c) override;
-
-    // Text helpers
-
-    void advance() override;
-    void setCursor(int x, int y);
-    void setTextColor(Color333 c) override;
-    void setTextSize(int s) override;
-    void drawChar(int x, int y, char ch, Color333 c) override;
-    void print(char ch) override;
-    void print(const char *s) override;
-    void println(const char *s) override;
+    // clear(), bulk fills, drawing API and text helpers come from RasterMatrix32
 };
 
 #endif // RGB_MATRIX_H
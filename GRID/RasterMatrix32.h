@@ -0,0 +1,500 @@
+#ifndef RASTER_MATRIX32_H
+#define RASTER_MATRIX32_H
+
+#include "GlyphCache.h"
+#include "Helpers.h"
+#include "Matrix32.h"
+#include <algorithm>
+
+// Shared drawing layer for framebuffer-backed Matrix32 backends (CRTP).
+//
+// A backend derives as `class X final : public RasterMatrix32<X>` and provides
+//   fb_[MATRIX_WIDTH * MATRIX_HEIGHT]  // row-major framebuffer of its native pixel type
+//   convertColor(Color333)             // Color333 -> native pixel
+//   wallMs()                           // wall-clock milliseconds (immediate-mode throttle)
+// plus begin(), set() and show(). Every primitive is implemented once here and
+// marked final. Primitives clip once, convert the color once, and store whole
+// row runs straight into fb_ with std::fill instead of going pixel by pixel
+// through the virtual set(). A backend whose fb_ is not a plain array (packed
+// palette indices, see IndexedPixels.h) also defines storePixel()/fillPixels()/
+// fillFrame(), which hide the defaults below, and a backend that counts draw calls
+// defines countDrawCall() the same way.
+//
+// Code that holds the concrete backend (scenes, via GridMatrix in AppContext)
+// gets the static path end to end. Code that holds a Matrix32& still works
+// through the virtual interface and pays one indirect call per primitive.
+template <class Backend>
+class RasterMatrix32 : public Matrix32
+{
+public:
+    // Origin-relative, clipped set. Hides Matrix32::setSafe so callers that
+    // know the backend type dispatch to Backend::set statically.
+    inline void setSafe(int x, int y, Color333 c)
+    {
+        x += originX_;
+        y += originY_;
+        if (inClip(x, y))
+            backend().set(x, y, c);
+    }
+
+    // Same as Matrix32::blitCols, with static fillRect calls.
+    inline void blitCols(int x0, int y0, const PixelMap *cols, int nCols, Color333 c, int ts)
+    {
+        blitColsTo(*this, x0, y0, cols, nCols, c, ts);
+    }
+
+    // Immediate mode is coalesced: each draw call presents at most once, and no
+    // more often than every immediateIntervalMs; plain set()/setSafe() writes
+    // never present on their own. Leaving immediate mode flushes what is left.
+    void setImmediate(bool on) final
+    {
+        const bool flush = immediate && !on && dirtyRows_ && !presentsHeld_;
+        immediate = on;
+        if (flush)
+            backend().show();
+    }
+    // Minimum wall time between immediate-mode presents (0 = every draw call)
+    void setImmediateInterval(millis_t ms) { immediateIntervalMs_ = ms; }
+
+    // Clear the whole framebuffer to black, ignoring clip and origin (never presents)
+    void clear() final
+    {
+        backend().fillFrame(Color333{0, 0, 0});
+        markAllDirty();
+    }
+
+    // Bulk-write API: clipped once, contiguous row stores, never presents
+
+    // Fill the inclusive run [x0..x1] on row y
+    void fillSpan(int x0, int x1, int y, Color333 c)
+    {
+        y += originY_;
+        if (y < clip_.y0 || y >= clip_.y1)
+            return;
+        x0 = std::max<int>(clip_.x0, x0 + originX_);
+        x1 = std::min<int>(clip_.x1 - 1, x1 + originX_);
+        if (x0 > x1)
+            return;
+        Backend &b = backend();
+        b.fillPixels(y * MATRIX_WIDTH + x0, x1 - x0 + 1, b.convertColor(c));
+        markRowDirty(y);
+    }
+
+    // Fill a w x h block at (x,y)
+    void fillBlock(int x, int y, int w, int h, Color333 c)
+    {
+        x += originX_;
+        y += originY_;
+        const int x0 = std::max<int>(clip_.x0, x), y0 = std::max<int>(clip_.y0, y);
+        const int x1 = std::min<int>(clip_.x1, x + w), y1 = std::min<int>(clip_.y1, y + h);
+        if (x0 >= x1 || y0 >= y1)
+            return;
+        Backend &b = backend();
+        if (x0 == 0 && y0 == 0 && x1 == MATRIX_WIDTH && y1 == MATRIX_HEIGHT)
+        {
+            b.fillFrame(c);
+            markAllDirty();
+            return;
+        }
+        const auto px = b.convertColor(c);
+        for (int yy = y0; yy < y1; ++yy)
+        {
+            b.fillPixels(yy * MATRIX_WIDTH + x0, x1 - x0, px);
+            markRowDirty(yy);
+        }
+    }
+
+    // Drawing API
+
+    // Draw a 5x7 glyph scaled by setTextSize() with its top-left at (x,y)
+    void drawChar(int x, int y, char ch, Color333 c) final
+    {
+        blitGlyph(x, y, ch, c, backend().convertColor(c));
+        presentImmediate();
+    }
+
+    // Draw a string with its top-left at (x,y) without touching the text cursor.
+    // '\n' starts a new line at x. Presents at most once in immediate mode.
+    void drawText(int x, int y, const char *s, Color333 c) final
+    {
+        blitText(x, y, x, s, c);
+        presentImmediate();
+    }
+
+    // Sprite blitter: each row and color index becomes one mask, clipped and
+    // filled run by run straight into fb_
+    void drawSprite(int x, int y, const Sprite32 &s, int frame = 0, uint8_t flip = Sprite32::FlipNone,
+                    const Color333 *palette = nullptr) final
+    {
+        const int sx = x + originX_, sy = y + originY_;
+        if (sx >= clip_.x1 || sy >= clip_.y1 || sx + s.w <= clip_.x0 || sy + s.h <= clip_.y0)
+            return;
+        if (!palette)
+            palette = s.palette;
+        Backend &b = backend();
+        decltype(b.convertColor(palette[0])) px[3];
+        for (int i = 0; i < s.colors(); ++i)
+            px[i] = b.convertColor(palette[i]);
+        const int row0 = std::max(0, clip_.y0 - sy), row1 = std::min<int>(s.h, clip_.y1 - sy);
+        for (int row = row0; row < row1; ++row)
+            for (int index = 1; index <= s.colors(); ++index)
+                fillRowBits(sx, sy + row, sy + row + 1, s.rowMask(frame, row, index, flip), px[index - 1]);
+        presentImmediate();
+    }
+
+    // Set one pixel (clipped)
+    void drawPixel(int x, int y, Color333 c) final
+    {
+        plot(x, y, c);
+        presentImmediate();
+    }
+
+    // Bresenham line. Cohen-Sutherland outcodes decide once per line: fully
+    // outside draws nothing, fully inside writes unchecked, only lines that
+    // cross the clip edge test each pixel (so clipped pixels match exactly).
+    void drawLine(int x0, int y0, int x1, int y1, Color333 c) final
+    {
+        x0 += originX_;
+        y0 += originY_;
+        x1 += originX_;
+        y1 += originY_;
+        const uint8_t code0 = outcode(x0, y0), code1 = outcode(x1, y1);
+        if (code0 & code1)
+            return;
+        if (code0 | code1)
+            traceLine<true>(x0, y0, x1, y1, c);
+        else
+            traceLine<false>(x0, y0, x1, y1, c);
+        presentImmediate();
+    }
+
+    // Rectangle outline
+    void drawRect(int x, int y, int w, int h, Color333 c) final
+    {
+        if (w <= 0 || h <= 0)
+            return;
+        drawHLine(x, y, w, c);
+        drawHLine(x, y + h - 1, w, c);
+        drawVLine(x, y, h, c);
+        drawVLine(x + w - 1, y, h, c);
+        presentImmediate();
+    }
+
+    // Midpoint circle outline; the bounding box is tested against the clip once
+    void drawCircle(int cx, int cy, int r, Color333 c) final
+    {
+        if (r < 0)
+            return;
+        cx += originX_;
+        cy += originY_;
+        if (cx + r < clip_.x0 || cx - r >= clip_.x1 || cy + r < clip_.y0 || cy - r >= clip_.y1)
+            return;
+        if (cx - r >= clip_.x0 && cx + r < clip_.x1 && cy - r >= clip_.y0 && cy + r < clip_.y1)
+            traceCircle<false>(cx, cy, r, c);
+        else
+            traceCircle<true>(cx, cy, r, c);
+        presentImmediate();
+    }
+
+    // Filled rectangle
+    void fillRect(int x, int y, int w, int h, Color333 c) final
+    {
+        fillBlock(x, y, w, h, c);
+        presentImmediate();
+    }
+
+    // Filled circle via spans (each span clipped once)
+    void fillCircle(int cx, int cy, int r, Color333 c) final
+    {
+        if (r < 0)
+            return;
+        int x = r, y = 0, err = 1 - r;
+        while (x >= y)
+        {
+            fillSpan(cx - x, cx + x, cy + y, c);
+            fillSpan(cx - x, cx + x, cy - y, c);
+            fillSpan(cx - y, cx + y, cy + x, c);
+            fillSpan(cx - y, cx + y, cy - x, c);
+            ++y;
+            if (err < 0)
+                err += 2 * y + 1;
+            else
+            {
+                --x;
+                err += 2 * (y - x) + 1;
+            }
+        }
+        presentImmediate();
+    }
+
+    // Text helpers
+
+    // Move cursor by 1 glyph (5px + 1px spacing) at current scale
+    void advance() final { cx += ts * FONT_CHAR_WIDTH; }
+
+    // Set text cursor
+    void setCursor(int x, int y) final
+    {
+        cx = x;
+        cy = y;
+        lineStartX = x;
+    }
+
+    // Set text color
+    void setTextColor(Color333 c) final { tc = c; }
+
+    // Set integer text scale >= 1
+    void setTextSize(int s) final { ts = std::max(1, s); }
+
+    // Print a single character (handles newline)
+    void print(char ch) final
+    {
+        const char s[2] = {ch, '\0'};
+        print(s);
+    }
+
+    // Print a C string at the cursor and advance it
+    void print(const char *s) final
+    {
+        blitText(cx, cy, lineStartX, s, tc);
+        presentImmediate();
+    }
+
+    // Print a C string then newline
+    void println(const char *s) final
+    {
+        print(s);
+        print('\n');
+    }
+
+protected:
+    // Text state
+    int cx{0};                      // cursor x in pixels
+    int cy{0};                      // cursor y in pixels
+    int lineStartX{0};              // start-of-line x for newline handling
+    int ts{1};                      // text scale
+    Color333 tc{Color333{7, 7, 7}}; // text color
+
+    static constexpr millis_t kDefaultImmediateIntervalMs = 16; // ~one display refresh
+    millis_t immediateIntervalMs_{kDefaultImmediateIntervalMs};
+    millis_t lastImmediateMs_{0};
+    bool immediatePresented_{false}; // lastImmediateMs_ is valid
+
+    // End of a draw call: present if in immediate mode and the interval allows;
+    // otherwise the rows stay dirty for the next draw call or the final flush
+    void presentImmediate()
+    {
+        backend().countDrawCall();
+        if (!immediate || presentsHeld_)
+            return;
+        const millis_t now = backend().wallMs();
+        if (immediatePresented_ && now - lastImmediateMs_ < immediateIntervalMs_)
+            return;
+        immediatePresented_ = true;
+        lastImmediateMs_ = now;
+        backend().show();
+    }
+
+    Backend &backend() { return static_cast<Backend &>(*this); }
+
+    // Called once at the end of every draw call; the default counts nothing
+    inline void countDrawCall() {}
+
+    // Default storage hooks for a plain fb_ array (i = y * MATRIX_WIDTH + x)
+    template <class Pixel>
+    inline void storePixel(int i, Pixel px) { backend().fb_[i] = px; }
+    template <class Pixel>
+    inline void fillPixels(int i, int n, Pixel px)
+    {
+        Backend &b = backend();
+        std::fill(b.fb_ + i, b.fb_ + i + n, px);
+    }
+    // Whole frame in one color (clear(), full-screen fills); gets the color
+    // itself, so a palette backend can start over from it
+    inline void fillFrame(Color333 c)
+    {
+        Backend &b = backend();
+        b.fillPixels(0, MATRIX_WIDTH * MATRIX_HEIGHT, b.convertColor(c));
+    }
+
+    // Unchecked framebuffer store; callers clip and mark rows dirty
+    inline void writePixel(int x, int y, Color333 c)
+    {
+        Backend &b = backend();
+        b.storePixel(y * MATRIX_WIDTH + x, b.convertColor(c));
+    }
+
+    // Screen-space pixel store of an already converted color; Checked tests the clip
+    template <bool Checked, class Pixel>
+    inline void plotScreen(int x, int y, Pixel px)
+    {
+        if (Checked && !inClip(x, y))
+            return;
+        backend().storePixel(y * MATRIX_WIDTH + x, px);
+        markRowDirty(y);
+    }
+
+    // Origin-relative, clipped pixel write; never presents
+    inline void plot(int x, int y, Color333 c)
+    {
+        plotScreen<true>(x + originX_, y + originY_, backend().convertColor(c));
+    }
+
+    // Cohen-Sutherland outcode of screen pixel (x,y) against the clip
+    uint8_t outcode(int x, int y) const
+    {
+        return uint8_t((x < clip_.x0 ? 1 : 0) | (x >= clip_.x1 ? 2 : 0) | (y < clip_.y0 ? 4 : 0) | (y >= clip_.y1 ? 8 : 0));
+    }
+
+    // Bresenham between screen points
+    template <bool Checked>
+    void traceLine(int x0, int y0, int x1, int y1, Color333 c)
+    {
+        const auto px = backend().convertColor(c);
+        int dx = x1 > x0 ? x1 - x0 : x0 - x1, sx = x0 < x1 ? 1 : -1;
+        int dy = -(y1 > y0 ? y1 - y0 : y0 - y1), sy = y0 < y1 ? 1 : -1;
+        int err = dx + dy;
+        while (true)
+        {
+            plotScreen<Checked>(x0, y0, px);
+            if (x0 == x1 && y0 == y1)
+                break;
+            int e2 = 2 * err;
+            if (e2 >= dy)
+            {
+                err += dy;
+                x0 += sx;
+            }
+            if (e2 <= dx)
+            {
+                err += dx;
+                y0 += sy;
+            }
+        }
+    }
+
+    // Midpoint circle around a screen point
+    template <bool Checked>
+    void traceCircle(int cx, int cy, int r, Color333 c)
+    {
+        const auto px = backend().convertColor(c);
+        int x = r, y = 0, err = 1 - r;
+        while (x >= y)
+        {
+            plot8<Checked>(cx, cy, x, y, px);
+            ++y;
+            if (err < 0)
+                err += 2 * y + 1;
+            else
+            {
+                --x;
+                err += 2 * (y - x) + 1;
+            }
+        }
+    }
+
+    // Draw a horizontal line in the framebuffer
+    void drawHLine(int x, int y, int w, Color333 c) { fillSpan(x, x + w - 1, y, c); }
+
+    // Draw a vertical line in the framebuffer
+    void drawVLine(int x, int y, int h, Color333 c) { fillBlock(x, y, 1, h, c); }
+
+    // Plot using 8-way symmetry for circle algorithms
+    template <bool Checked, class Pixel>
+    void plot8(int cx, int cy, int x, int y, Pixel px)
+    {
+        plotScreen<Checked>(cx + x, cy + y, px);
+        plotScreen<Checked>(cx - x, cy + y, px);
+        plotScreen<Checked>(cx + x, cy - y, px);
+        plotScreen<Checked>(cx - x, cy - y, px);
+        plotScreen<Checked>(cx + y, cy + x, px);
+        plotScreen<Checked>(cx - y, cy + x, px);
+        plotScreen<Checked>(cx + y, cy - x, px);
+        plotScreen<Checked>(cx - y, cy - x, px);
+    }
+
+    // Blit s at (x,y), advancing x one glyph per char; '\n' returns to lineX one line down.
+    // Each line is clipped vertically once; glyphs off either side only advance.
+    void blitText(int &x, int &y, int lineX, const char *s, Color333 c)
+    {
+        const auto px = backend().convertColor(c);
+        const int glyphW = FONT_GLYPH_WIDTH * ts, glyphH = FONT_GLYPH_HEIGHT * ts;
+        auto visibleRow = [&](int ly) { return ly + originY_ < clip_.y1 && ly + originY_ + glyphH > clip_.y0; };
+        bool lineVisible = visibleRow(y);
+        for (const char *p = s; *p; ++p)
+        {
+            if (*p == '\n')
+            {
+                x = lineX;
+                y += ts * (FONT_CHAR_HEIGHT + 1);
+                lineVisible = visibleRow(y);
+                continue;
+            }
+            if (lineVisible && x + originX_ < clip_.x1 && x + originX_ + glyphW > clip_.x0)
+                blitGlyph(x, y, *p, c, px);
+            x += ts * FONT_CHAR_WIDTH;
+        }
+    }
+
+    // Blit one glyph with its top-left at local (x,y): each glyph row is a scaled
+    // bitmask whose lit runs are filled straight into fb_ for ts screen rows
+    template <class Pixel>
+    void blitGlyph(int x, int y, char ch, Color333 c, Pixel px)
+    {
+        GlyphCache &glyphs = GlyphCache::shared();
+        const uint8_t *rows = glyphs.rows(ch);
+        if (!rows || x + originX_ >= clip_.x1 || y + originY_ >= clip_.y1)
+            return;
+        if (ts > GlyphCache::kMaxScale)
+        {
+            // Glyph wider than one mask (and than the matrix): plain blocks
+            for (int row = 0; row < FONT_GLYPH_HEIGHT; ++row)
+                for (int col = 0; col < FONT_GLYPH_WIDTH; ++col)
+                    if (rows[row] & (1u << col))
+                        fillBlock(x + col * ts, y + row * ts, ts, ts, c);
+            return;
+        }
+        const int sx = x + originX_, sy = y + originY_;
+        for (int row = 0; row < FONT_GLYPH_HEIGHT; ++row)
+        {
+            const int y0 = std::max<int>(clip_.y0, sy + row * ts), y1 = std::min<int>(clip_.y1, sy + (row + 1) * ts);
+            if (y0 >= y1 || !rows[row])
+                continue;
+            fillRowBits(sx, y0, y1, glyphs.scaled(rows[row], ts), px);
+        }
+    }
+
+    // Fill the lit runs of a row mask (bit i = screen column xs + i) on screen
+    // rows [y0,y1), which must lie inside the clip; clips horizontally
+    template <class Pixel>
+    void fillRowBits(int xs, int y0, int y1, uint32_t bits, Pixel px)
+    {
+        if (xs < clip_.x0)
+        {
+            if (clip_.x0 - xs >= 32)
+                return;
+            bits >>= clip_.x0 - xs;
+            xs = clip_.x0;
+        }
+        if (xs >= clip_.x1)
+            return;
+        if (clip_.x1 - xs < 32)
+            bits &= (uint32_t(1) << (clip_.x1 - xs)) - 1;
+        if (!bits)
+            return;
+        Backend &b = backend();
+        while (bits)
+        {
+            const int start = __builtin_ctz(bits);
+            const uint32_t rest = ~(bits >> start);
+            const int len = rest ? __builtin_ctz(rest) : 32 - start;
+            for (int yy = y0; yy < y1; ++yy)
+                b.fillPixels(yy * MATRIX_WIDTH + xs + start, len, px);
+            bits &= len < 32 ? ~(((uint32_t(1) << len) - 1) << start) : 0;
+        }
+        for (int yy = y0; yy < y1; ++yy)
+            markRowDirty(yy);
+    }
+};
+
+#endif // RASTER_MATRIX32_H
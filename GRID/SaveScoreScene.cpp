@@ -1,5 +1,6 @@
 #include "SaveScoreScene.h"
 #include "SceneBus.h"
+#include "Trace.h"
 
 const Color333 SaveScoreScene::kTextColor = Colors::Muted::White;
 const Color333 SaveScoreScene::kSelectedColor = ColorHSV333(0, 0, 150);
@@ -9,6 +10,9 @@ const char SaveScoreScene::kAlphabet[];
 
 void SaveScoreScene::setStage(AppContext &ctx, Stage newStage)
 {
+    static const char *const kStageNames[] = {"SaveScore: ShowIntro", "SaveScore: InputName", "SaveScore: ShowSaved",
+                                              "SaveScore: ShowError", "SaveScore: End"};
+    GRID_TRACE_SCOPE(kStageNames[newStage], "stage");
     startTime_ = ctx.time.nowMs();
     stage_ = newStage;
 }
@@ -3,6 +3,7 @@
 
 #include "AppContext.h"
 #include "Helpers.h"
+#include "PostFX32.h"
 #include "Timing.h"
 #include <cmath>
 #include <limits>
@@ -36,8 +37,21 @@ struct Scene
   virtual SceneTimingPrefs timingPrefs() const { return SceneTimingPrefs(std::numeric_limits<float>::quiet_NaN()); };
   // Called once when the scene is switched to
   virtual void setup(AppContext &ctx) = 0;
-  // dt is in milliseconds
+  // Update phase: advance the scene by one step (most scenes also draw here)
   virtual void loop(AppContext &cfx) = 0;
+  // Draw phase, once per presented frame after one or more loop() steps.
+  // Scenes that keep state from one step to the next can draw it here,
+  // blended by ctx.time.alpha().
+  virtual void render(AppContext &) {}
+  // True to be rendered between steps as well, so render() can draw
+  // in-between positions when the display outpaces the scene's step rate
+  virtual bool interpolates() const { return false; }
+  // Called when the pause menu closes and the scene continues. The menu has
+  // overwritten the screen, so scenes that only redraw what changed start over.
+  virtual void resume(AppContext &) {}
+  // Post-processing App applies around loop() and render(), or nullptr for none. Asked
+  // again every frame, so a scene can switch effects between stages.
+  virtual const PostFX32 *postFX() const { return nullptr; }
 };
 
 #endif
@@ -1,7 +1,7 @@
 #ifndef SCROLL_TEXT_HELPER_H
 #define SCROLL_TEXT_HELPER_H
 
-#include "Matrix32.h"
+#include "GridMatrix.h"
 
 /**
  * @brief Horizontally scrolling, single-line banner renderer.
@@ -11,6 +11,10 @@
  *   s.prepare("Hello", 1, Colors::Bright::White, Colors::Black, true, true);
  *   s.reset(MATRIX_WIDTH, ScrollText::yTopCentered(s.ts));
  *   while (running) { s.step(-1, gfx); }
+ *
+ * The matrix is a template parameter: pass the concrete backend for static
+ * dispatch, or a DisplayListMatrix32 to record a frame, which merges the
+ * per-column runs blitCols() emits into a few wide fills before rasterizing.
  */
 struct ScrollText
 {
@@ -56,7 +60,7 @@ struct ScrollText
      *
      * Newlines are ignored for single-line banners.
      *
-     * @param m                Matrix32 instance to use for graphics
+     * @param m                Matrix backend to use for graphics
      * @param message          C-string text to scroll.
      * @param scale            Integer scale for the 5x7 font.
      * @param color            Foreground text color.
@@ -64,7 +68,8 @@ struct ScrollText
      * @param fillBackground   If true, fills the text band each frame.
      * @param shouldLoop       If true, enables seamless looping.
      */
-    void prepare(Matrix32 &m, const char *message, int scale, Color333 color,
+    template <class Matrix>
+    void prepare(Matrix &m, const char *message, int scale, Color333 color,
                  Color333 bgColor = Colors::Black, bool fillBackground = true, bool shouldLoop = false)
     {
         ts = std::max(1, scale);
@@ -109,12 +114,13 @@ struct ScrollText
      * Ensures one present per frame when Matrix32::immediate == false.
      * If looping, draws a wrapped copy offset by the full text width.
      *
-     * @param m   Matrix32 target renderer.
+     * @param m   Matrix backend to draw into.
      * @param dx  Horizontal delta in pixels per call (negative to scroll left).
      * @return    If loop==false: true when the banner has fully exited left.
      *            If loop==true: always false (continuous).
      */
-    bool step(Matrix32 &m, int dx)
+    template <class Matrix>
+    bool step(Matrix &m, int dx)
     {
         if (useBg)
         {
@@ -166,7 +172,8 @@ struct ScrollText
 
     // Render ScrollText without clearing its band and without presenting.
     // Advances x by dx. Returns "finished" semantics like step().
-    bool stepNoBgNoPresent(Matrix32 &m, int dx)
+    template <class Matrix>
+    bool stepNoBgNoPresent(Matrix &m, int dx)
     {
         if (!cols.empty())
         {
@@ -135,7 +135,7 @@ bool Snake::checkCollision(Node *newHead) const
     return false;
 }
 
-void Snake::draw(class Matrix32 &gfx, Color333 color, std::bitset<MATRIX_WIDTH * MATRIX_HEIGHT> &occupied) const
+void Snake::draw(GridMatrix &gfx, Color333 color, std::bitset<MATRIX_WIDTH * MATRIX_HEIGHT> &occupied) const
 {
     Node *current = head_;
     while (current)
@@ -151,6 +151,8 @@ void Snake::draw(class Matrix32 &gfx, Color333 color, std::bitset<MATRIX_WIDTH *
     }
 }
 
+const Color333 SnakeScene::kFoodColor = Colors::Bright::Red;
+
 SnakeScene::SnakeScene() : snake_(Snake::kInitialLength - 1 + Helpers::random(MATRIX_WIDTH - Snake::kInitialLength),
                                   Snake::kInitialLength - 1 + Helpers::random(MATRIX_HEIGHT - Snake::kInitialLength)) // Randomly place snake
 {
@@ -158,6 +160,8 @@ SnakeScene::SnakeScene() : snake_(Snake::kInitialLength - 1 + Helpers::random(MA
 
 void SnakeScene::setup(AppContext &ctx)
 {
+    // Only the food passes the threshold; the muted snake gets no halo
+    foodGlow_.glowThreshold = kFoodColor.r;
     placeFood();
 }
 
@@ -273,7 +277,7 @@ void SnakeScene::loop(AppContext &ctx)
         snake_.draw(ctx.gfx, Colors::Muted::Green, occupied_);
 
         // Draw food
-        ctx.gfx.setSafe(foodX_, foodY_, Colors::Muted::Red);
+        ctx.gfx.setSafe(foodX_, foodY_, kFoodColor);
 
         break;
     }
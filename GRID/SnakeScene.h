@@ -43,7 +43,7 @@ public:
     void setDirection(Direction dir);
     int getLength() const;
     bool hasCollided() const { return collided_; }
-    void draw(class Matrix32 &gfx, Color333 color, std::bitset<MATRIX_WIDTH * MATRIX_HEIGHT> &occupied) const;
+    void draw(GridMatrix &gfx, Color333 color, std::bitset<MATRIX_WIDTH * MATRIX_HEIGHT> &occupied) const;
 
 private:
     Direction direction_;
@@ -56,6 +56,9 @@ class SnakeScene : public Scene
     int foodY_;
     int score_ = 0;
     static constexpr int kScorePerFood = 10;
+    // Full red (the food was Muted::Red before the glow): a level-1 pixel
+    // averages to 0 in the 3x3 glow blur, so a muted food gets no halo
+    static const Color333 kFoodColor;
 
     void placeFood();
     using PixelMap = std::bitset<MATRIX_WIDTH * MATRIX_HEIGHT>;
@@ -73,6 +76,7 @@ class SnakeScene : public Scene
         EndGame
     };
     Stage stage = Stage::Game;
+    PostFX32 foodGlow_; // halo around the food while playing
 
     ScoreData highScore_;
     bool loadHighScore(AppContext &ctx, ScoreData &highScore);
@@ -90,6 +94,7 @@ public:
     void setup(AppContext &ctx) override;
 
     void loop(AppContext &ctx) override;
+    const PostFX32 *postFX() const override { return stage == Stage::Game ? &foodGlow_ : nullptr; }
 
     SceneKind kind() const override { return SceneKind::Snake; }
     const char *label() const override { return "Snake"; }
@@ -0,0 +1,95 @@
+#ifndef SPRITE32_H
+#define SPRITE32_H
+
+#include "Colors.h"
+#include <cstdint>
+
+// Bit-packed sprite or sprite sheet, meant to live in const (flash) memory.
+//
+// Each frame is w x h pixels (w <= 32) stored as bpp planes of h rows. A
+// pixel's color index is its plane bits (plane 0 = low bit): index 0 is
+// transparent, indices 1..(2^bpp - 1) pick palette entries. Rows are packed
+// back to back into one bit stream, w bits each, least significant bit
+// first, frame by frame and plane by plane; the row for (frame, plane, row)
+// starts at bit
+//   ((frame * bpp + plane) * h + row) * w
+// so a 1-bit sprite costs w * h / 8 bytes. rowMask() decodes a row into a
+// mask whose bit i is column i (bit 0 = leftmost), like the text blitter's
+// glyph rows, and Matrix32::drawSprite() fills its runs, so a sprite costs
+// a few stores per row instead of a call per pixel. Sprites are generated
+// from text art in assets/ by `make assets` (see emulation/assetpack).
+struct Sprite32
+{
+    // Flip flags for drawSprite()
+    enum Flip : uint8_t
+    {
+        FlipNone = 0,
+        FlipH = 1, // mirror left-right
+        FlipV = 2  // mirror top-bottom
+    };
+
+    uint8_t w, h;            // frame size in pixels (w <= 32)
+    uint8_t bpp;             // mask planes: 1 (one color) or 2 (three colors)
+    uint8_t frames;          // frames in the sheet
+    const uint8_t *bits;     // packed rows, see above
+    const Color333 *palette; // colors of indices 1..(2^bpp - 1)
+
+    int colors() const { return (1 << bpp) - 1; }
+
+    // Mask of the pixels of color index (1..colors()) on row `row` of frame
+    // `frame` as drawn with `flip`; bit i = sprite column i
+    uint32_t rowMask(int frame, int row, int index, uint8_t flip) const
+    {
+        if (flip & FlipV)
+            row = h - 1 - row;
+        const uint32_t at = uint32_t((frame * bpp * h + row) * w);
+        uint32_t m;
+        if (bpp == 1)
+            m = readBits(bits, at, w);
+        else
+        {
+            const uint32_t lo = readBits(bits, at, w), hi = readBits(bits, at + uint32_t(h * w), w);
+            m = (index & 1 ? lo : ~lo) & (index & 2 ? hi : ~hi);
+            if (w < 32)
+                m &= (uint32_t(1) << w) - 1;
+        }
+        return (flip & FlipH) ? reverse(m, w) : m;
+    }
+
+    // Color index of pixel (x,y) of frame `frame` (0 = transparent)
+    int index(int frame, int x, int y) const
+    {
+        int idx = 0;
+        for (int p = 0; p < bpp; ++p)
+            idx |= int(readBits(bits, uint32_t(((frame * bpp + p) * h + y) * w + x), 1)) << p;
+        return idx;
+    }
+
+    // n (1..32) bits of stream p starting at bit `at`
+    static uint32_t readBits(const uint8_t *p, uint32_t at, int n)
+    {
+        p += at >> 3;
+        const int shift = int(at & 7);
+        const int bytes = (shift + n + 7) >> 3; // 1..5
+        uint32_t v = 0;
+        for (int i = 0; i < bytes && i < 4; ++i)
+            v |= uint32_t(p[i]) << (8 * i);
+        v >>= shift;
+        if (bytes == 5)
+            v |= uint32_t(p[4]) << (32 - shift);
+        return n < 32 ? v & ((uint32_t(1) << n) - 1) : v;
+    }
+
+    // Mirror the low n bits of m
+    static uint32_t reverse(uint32_t m, int n)
+    {
+        m = (m >> 1 & 0x55555555u) | (m & 0x55555555u) << 1;
+        m = (m >> 2 & 0x33333333u) | (m & 0x33333333u) << 2;
+        m = (m >> 4 & 0x0F0F0F0Fu) | (m & 0x0F0F0F0Fu) << 4;
+        m = (m >> 8 & 0x00FF00FFu) | (m & 0x00FF00FFu) << 8;
+        m = (m >> 16) | (m << 16);
+        return m >> (32 - n);
+    }
+};
+
+#endif // SPRITE32_H
@@ -30,24 +30,8 @@ private:
     static const int kBandTop = 12;        // Y top for GRID band
     static const int kBannerShiftUp = 10;  // shift "Welcome to the" upward
 
-    // Per-letter widths (columns)
-    static const uint8_t kGWidth = 8;
-    static const uint8_t kRWidth = 8;
-    static const uint8_t kIWidth = 2;
-    static const uint8_t kDWidth = 8;
-
-    // Column tables use the matching widths above
-    static const uint16_t G_cols[kGWidth];
-    static const uint16_t R_cols[kRWidth];
-    static const uint16_t I_cols[kIWidth];
-    static const uint16_t D_cols[kDWidth];
-
-    struct Glyph
-    {
-        const uint16_t *cols;
-        uint8_t w;
-    };
-    static const Glyph kWord[kWordLetters]; // = { G, R, I, D }
+    // Columns each letter of Assets::kGridLogo advances the cursor (the I only uses two)
+    static const uint8_t kLetterW[kWordLetters];
 
     ScrollText banner_;
     bool bannerDone_{false};
@@ -84,18 +84,22 @@ void TestScene::run_color_tests(AppContext &ctx)
     m.clear();
 
     test_hue_sweep(m);
+    m.show();
     ctx.time.sleep(2000);
     m.clear();
 
     test_brightness_ramp(m);
+    m.show();
     ctx.time.sleep(2000);
     m.clear();
 
     test_primary_blocks(m);
+    m.show();
     ctx.time.sleep(2000);
     m.clear();
 
     test_saturation_stripes(m);
+    m.show();
 }
 
 #ifdef GRID_EMULATION
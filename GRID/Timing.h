@@ -21,12 +21,18 @@ struct Timing
   virtual ~Timing() = default;
   virtual millis_t nowMs() const = 0;
   virtual float dtMs() const = 0;
-  virtual float fps() const = 0;
   virtual double targetHz() const = 0; // use double for stability & precision
   virtual void setTargetHz(double hz) = 0;
   virtual void applyPreference(SceneTimingPrefs pref) = 0;
   virtual void resetSceneClock() = 0;
   virtual void sleep(millis_t ms) = 0;
+  // Fraction (0..1) of a fixed step that has elapsed since the last update,
+  // for scenes that draw between steps. Timings that update once per frame
+  // report 1: draw the latest state.
+  virtual float alpha() const { return 1.0f; }
+  // Free-running microsecond clock for measuring cost (wraps; not scene
+  // time, so it keeps running under a simulated clock)
+  virtual uint32_t nowUs() const { return Helpers::microsNow(); }
 };
 
 #endif // TIMING_H
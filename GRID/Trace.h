@@ -0,0 +1,96 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Frame timeline tracer (emulator only).
+//
+// GRID_TRACE_SCOPE(name, category) records a begin event now and the
+// matching end event when the enclosing scope exits; GRID_TRACE_INSTANT
+// records a single point in time. Names and categories must be string
+// literals (or other strings that outlive the trace): only the pointers are
+// stored. Trace::start() turns recording on and Trace::stop(path) writes the
+// Trace Event JSON that chrome://tracing and ui.perfetto.dev open.
+//
+// Each thread appends to its own preallocated buffer (allocated on its first
+// event), so recording takes no locks; a full buffer drops further events and
+// counts them. While no trace is running, a scope costs one relaxed atomic
+// load. On the board the macros compile to nothing.
+#if defined(GRID_EMULATION)
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Trace
+{
+static constexpr size_t kDefaultEventsPerThread = size_t(1) << 17; // 4 MB per thread
+
+namespace detail
+{
+extern std::atomic<bool> active;
+}
+
+// True while a trace is being recorded
+inline bool active() { return detail::active.load(std::memory_order_relaxed); }
+
+// Start recording; each thread that records gets room for eventsPerThread events
+void start(size_t eventsPerThread = kDefaultEventsPerThread);
+// Stop recording and write everything to path; false if it cannot be written
+bool stop(const char *path);
+// Events recorded / dropped because a thread's buffer was full, since start()
+size_t recorded();
+size_t dropped();
+
+// Name the calling thread in the trace (any time; the name must outlive the trace)
+void setThreadName(const char *name);
+
+void begin(const char *name, const char *cat);
+void end(const char *name, const char *cat);
+void instant(const char *name, const char *cat);
+
+// Begin/end pair around a scope; decides once, at construction, whether to record
+class Scope
+{
+    const char *name_;
+    const char *cat_;
+    bool on_;
+
+public:
+    Scope(const char *name, const char *cat) : name_(name), cat_(cat), on_(active())
+    {
+        if (on_)
+            begin(name_, cat_);
+    }
+    ~Scope()
+    {
+        if (on_)
+            end(name_, cat_);
+    }
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+};
+} // namespace Trace
+
+#define GRID_TRACE_JOIN2(a, b) a##b
+#define GRID_TRACE_JOIN(a, b) GRID_TRACE_JOIN2(a, b)
+#define GRID_TRACE_SCOPE(name, cat) Trace::Scope GRID_TRACE_JOIN(traceScope_, __LINE__)(name, cat)
+#define GRID_TRACE_INSTANT(name, cat)       \
+    do                                      \
+    {                                       \
+        if (Trace::active())                \
+            Trace::instant(name, cat);      \
+    } while (0)
+
+#else
+
+// sizeof keeps the arguments referenced (no unused warnings) without evaluating them
+#define GRID_TRACE_SCOPE(name, cat) \
+    do                              \
+    {                               \
+        (void)sizeof(name);         \
+        (void)sizeof(cat);          \
+    } while (0)
+#define GRID_TRACE_INSTANT(name, cat) GRID_TRACE_SCOPE(name, cat)
+
+#endif // GRID_EMULATION
+
+#endif // TRACE_H
@@ -0,0 +1,125 @@
+#ifndef TRANSITION32_H
+#define TRANSITION32_H
+
+#include "Canvas32.h"
+#include "Helpers.h"
+#include <cstdint>
+
+// Scene transition compositor: animates from one captured frame to another.
+//
+// from() holds the outgoing frame and to() the incoming one (about 4.2 KB
+// together with the canvases' drawing state, so App only allocates a
+// Transition32 while one is running). Each step maps the elapsed time to a
+// fixed-point progress t in 0..256 and writes every row of the in-between
+// frame to the target; at t == 256 the output is to() exactly. Row kernels
+// work on packed Color333 codes with integer math only:
+//   Blend  cross-fade; a 64-entry mix table per step, three lookups per pixel
+//   Wipe   incoming frame uncovered from the left edge
+//   Slide  incoming frame pushes the outgoing one out to the left
+class Transition32
+{
+public:
+    enum class Kind : uint8_t
+    {
+        Cut, // no transition
+        Blend,
+        Wipe,
+        Slide
+    };
+
+    static constexpr uint16_t kOne = 256; // progress fixed-point scale
+
+    Canvas32 &from() { return from_; }
+    Canvas32 &to() { return to_; }
+    Kind kind() const { return kind_; }
+
+    void start(Kind kind, millis_t durationMs, millis_t nowMs)
+    {
+        kind_ = kind;
+        durationMs_ = durationMs;
+        startMs_ = nowMs;
+    }
+
+    // Progress at nowMs, 0..kOne
+    uint16_t progress(millis_t nowMs) const
+    {
+        const millis_t elapsed = nowMs - startMs_;
+        if (!durationMs_ || elapsed >= durationMs_)
+            return kOne;
+        return uint16_t(uint32_t(elapsed) * kOne / durationMs_);
+    }
+
+    // Write the frame for nowMs into gfx; returns false once the last frame
+    // (to() exactly) has been written
+    template <class Target>
+    bool step(Target &gfx, millis_t nowMs)
+    {
+        const uint16_t t = progress(nowMs);
+        compose(gfx, t);
+        return t < kOne;
+    }
+
+    // Write the frame at progress t into gfx
+    template <class Target>
+    void compose(Target &gfx, uint16_t t)
+    {
+        if (kind_ == Kind::Blend)
+            buildMix(t);
+        uint16_t row[MATRIX_WIDTH];
+        for (int y = 0; y < MATRIX_HEIGHT; ++y)
+        {
+            composeRow(y, t, row);
+            for (int x = 0; x < MATRIX_WIDTH; ++x)
+                gfx.set(x, y, unpackColor333(row[x]));
+        }
+    }
+
+private:
+    Canvas32 from_;
+    Canvas32 to_;
+    Kind kind_{Kind::Cut};
+    millis_t durationMs_{0};
+    millis_t startMs_{0};
+    uint8_t mix_[8][8]; // Blend: mix_[a][b] = a..b at the current t
+
+    void buildMix(uint16_t t)
+    {
+        for (int a = 0; a < 8; ++a)
+            for (int b = 0; b < 8; ++b)
+                mix_[a][b] = uint8_t((a * (kOne - t) + b * t + kOne / 2) >> 8);
+    }
+
+    void composeRow(int y, uint16_t t, uint16_t *out) const
+    {
+        const uint16_t *a = from_.row(y), *b = to_.row(y);
+        switch (kind_)
+        {
+        case Kind::Blend:
+            for (int x = 0; x < MATRIX_WIDTH; ++x)
+                out[x] = uint16_t(mix_[a[x] >> 6][b[x] >> 6] << 6 |
+                                  mix_[(a[x] >> 3) & 7][(b[x] >> 3) & 7] << 3 |
+                                  mix_[a[x] & 7][b[x] & 7]);
+            break;
+        case Kind::Wipe:
+        {
+            const int edge = (t * MATRIX_WIDTH + kOne / 2) >> 8;
+            for (int x = 0; x < MATRIX_WIDTH; ++x)
+                out[x] = x < edge ? b[x] : a[x];
+            break;
+        }
+        case Kind::Slide:
+        {
+            const int shift = (t * MATRIX_WIDTH + kOne / 2) >> 8;
+            for (int x = 0; x < MATRIX_WIDTH; ++x)
+                out[x] = x + shift < MATRIX_WIDTH ? a[x + shift] : b[x + shift - MATRIX_WIDTH];
+            break;
+        }
+        case Kind::Cut:
+            for (int x = 0; x < MATRIX_WIDTH; ++x)
+                out[x] = b[x];
+            break;
+        }
+    }
+};
+
+#endif // TRANSITION32_H
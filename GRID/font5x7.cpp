@@ -1,3 +1,6 @@
+// Generated by assetpack (`make assets`) from assets/font5x7.txt.
+// Edit the sources and regenerate instead of editing this file.
+
 #include <cstdint>
 
 using PixelMap = uint8_t;
@@ -11,7 +14,7 @@ extern const PixelMap FONT5x7[96][5] = {
     /* '$' */ {0x24, 0x2A, 0x7F, 0x2A, 0x12},
     /* '%' */ {0x23, 0x13, 0x08, 0x64, 0x62},
     /* '&' */ {0x36, 0x49, 0x55, 0x22, 0x50},
-    /* '\' */ {0x00, 0x05, 0x03, 0x00, 0x00},
+    /* '\'' */ {0x00, 0x05, 0x03, 0x00, 0x00},
     /* '(' */ {0x00, 0x1C, 0x22, 0x41, 0x00},
     /* ')' */ {0x00, 0x41, 0x22, 0x1C, 0x00},
     /* '*' */ {0x14, 0x08, 0x3E, 0x08, 0x14},
@@ -64,7 +67,7 @@ extern const PixelMap FONT5x7[96][5] = {
     /* 'Y' */ {0x07, 0x08, 0x70, 0x08, 0x07},
     /* 'Z' */ {0x61, 0x51, 0x49, 0x45, 0x43},
     /* '[' */ {0x00, 0x7F, 0x41, 0x41, 0x00},
-    /* '\' */ {0x02, 0x04, 0x08, 0x10, 0x20},
+    /* '\\' */ {0x02, 0x04, 0x08, 0x10, 0x20},
     /* ']' */ {0x00, 0x41, 0x41, 0x7F, 0x00},
     /* '^' */ {0x04, 0x02, 0x01, 0x02, 0x04},
     /* '_' */ {0x40, 0x40, 0x40, 0x40, 0x40},
@@ -0,0 +1,57 @@
+#ifndef COLOR888_LUT_H
+#define COLOR888_LUT_H
+
+#include "Colors.h"
+
+// Color333 -> Color888 conversion shared by the emulator backends
+// (SDLMatrix32, MemoryMatrix32), so their framebuffers stay byte-identical.
+
+/*
+Mapping 3-bit intensities (0..7) to 8-bit (0..255) using a perceptual curve.
+
+Background:
+- A linear map (v * 255 / 7) looks too dim at low codes in emulation compared
+  to real LEDs. Human brightness perception is non-linear, so we apply an
+  inverse‑gamma curve to brighten lows.
+
+How this LUT was computed:
+1) Choose a target for v=1 in 8-bit space (Y1). Here we use Y1 = 150.
+2) Solve for the curve exponent (gamma_inv) that hits that anchor:
+     gamma_inv = ln(Y1 / 255) / ln(1 / 7)
+3) For each v in [0..7], compute:
+     LUT[v] = round( (v / 7)^gamma_inv * 255 )
+   with hard anchors LUT[0] = 0 and LUT[7] = 255.
+
+Notes:
+- This keeps v=7 at full scale while making v=1 “noticeably bright”.
+- If highlights feel too hot, increase Y1? No—decrease it (or clamp results).
+  If lows are still dull, increase Y1.
+- Regenerate the table by changing Y1 and re-running the formula above.
+*/
+// v: 0..7  ->  0..255 with inverse-gamma to brighten low codes
+inline constexpr Intensity8 kExpand3to8Gamma[8] = {0, 150, 181, 202, 220, 233, 245, 255};
+
+// Color333 -> Color888: three loads from the 8-byte curve. A 512-entry table
+// indexed by packColor333() is slower here (grid-microbench, "color888"):
+// packing the code costs more than the two loads it saves.
+inline Color888 toColor888(Color333 c)
+{
+    return Color888{kExpand3to8Gamma[c.r & 0x7], kExpand3to8Gamma[c.g & 0x7], kExpand3to8Gamma[c.b & 0x7]};
+}
+
+// 8-bit channel -> 3-bit code: the largest code whose curve value is <= v
+inline Intensity3 shrink8to3Gamma(Intensity8 v)
+{
+    Intensity3 i = 7;
+    while (i && kExpand3to8Gamma[i] > v)
+        --i;
+    return i;
+}
+
+// Color888 -> packed Color333 code; exact inverse of toColor888 for the colors it produces
+inline uint16_t codeOf888(Color888 c)
+{
+    return static_cast<uint16_t>((shrink8to3Gamma(c.r) << 6) | (shrink8to3Gamma(c.g) << 3) | shrink8to3Gamma(c.b));
+}
+
+#endif // COLOR888_LUT_H
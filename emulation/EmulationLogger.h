@@ -3,6 +3,7 @@
 #define EMULATION_LOGGER_H
 
 #include "Logging.h"
+#include "Trace.h"
 
 struct StdoutSink final : ILogSink
 {
@@ -37,7 +38,11 @@ public:
             core_.write(buf, size_t(n < int(sizeof(buf)) ? n : int(sizeof(buf)) - 1), lvl == LogLevel::Warning);
         core_.end(lvl);
     }
-    void flush() override { core_.flush(); }
+    void flush() override
+    {
+        GRID_TRACE_SCOPE("logger flush", "log");
+        core_.flush();
+    }
 
 private:
     LoggerCore core_;
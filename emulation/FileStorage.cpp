@@ -8,6 +8,7 @@
 #include <filesystem>
 #include <fstream>
 #include "Logging.h" // Provides ILogger and LogLevel
+#include "Trace.h"
 
 namespace fs = std::filesystem;
 
@@ -62,12 +63,14 @@ StorageResult FileStorage::init(const char *dir, ILogger *logger)
 
 bool FileStorage::exists(const char *rel)
 {
+    GRID_TRACE_SCOPE("storage exists", "storage");
     std::error_code ec;
     return fs::exists(joinUnder(baseDir, rel), ec);
 }
 
 StorageResult FileStorage::writeAll(const char *rel, const void *src, size_t n)
 {
+    GRID_TRACE_SCOPE("storage writeAll", "storage");
     const std::string abs = joinUnder(baseDir, rel);
     const std::string tmp = joinUnder(baseDir, kTempName);
 
@@ -109,6 +112,7 @@ StorageResult FileStorage::writeAll(const char *rel, const void *src, size_t n)
 
 StorageResult FileStorage::readAll(const char *rel, void *dst, size_t cap)
 {
+    GRID_TRACE_SCOPE("storage readAll", "storage");
     const std::string abs = joinUnder(baseDir, rel);
     std::ifstream f(abs, std::ios::binary);
     if (!f)
@@ -136,6 +140,7 @@ StorageResult FileStorage::readAll(const char *rel, void *dst, size_t cap)
 
 StorageResult FileStorage::removeFile(const char *rel)
 {
+    GRID_TRACE_SCOPE("storage removeFile", "storage");
     std::error_code ec;
     fs::remove(joinUnder(baseDir, rel), ec);
     if (ec)
@@ -149,6 +154,7 @@ StorageResult FileStorage::removeFile(const char *rel)
 
 StorageResult FileStorage::removeTree(const char *relDir)
 {
+    GRID_TRACE_SCOPE("storage removeTree", "storage");
     std::error_code ec;
     fs::remove_all(joinUnder(baseDir, relDir), ec);
     if (ec)
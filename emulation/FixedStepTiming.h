@@ -17,8 +17,6 @@ class FixedStepTiming final : public Timing
     uint64_t freq_ = 0, last_ = 0;
     uint32_t nowMs_ = 0; // scene clock
     float dtMs_ = 0.0f;
-    float fpsEMA_ = 0.0f;                  // exponential moving average of fps
-    static constexpr float k_alpha = 0.2f; // EMA smoothing factor
 
 public:
     explicit FixedStepTiming(double targetHz)
@@ -47,17 +45,14 @@ public:
             nowMs_ += static_cast<uint32_t>(dtSec_ * MILLIS_PER_SEC);
             dtMs_ = static_cast<float>(dtSec_ * MILLIS_PER_SEC);
         }
-        if (steps > 0)
-        {
-            float fpsInst = static_cast<float>(targetHz_);
-            fpsEMA_ = fpsEMA_ <= 0 ? fpsInst : k_alpha * fpsInst + (1 - k_alpha) * fpsEMA_;
-        }
         return steps;
     }
 
-    void sleep_to_cadence()
+    // Sleep until the next step is due, or for at most capSec (e.g. one
+    // display refresh, for scenes that are drawn between steps)
+    void sleep_to_cadence(double capSec = 1.0)
     {
-        double left = dtSec_ - acc_;
+        double left = std::min(dtSec_ - acc_, capSec);
         if (left > 0.0)
         {
             double sleepSec = std::max(0.0, left - 0.001);
@@ -68,8 +63,15 @@ public:
     // Timing API
     uint32_t nowMs() const override { return nowMs_; }
     float dtMs() const override { return dtMs_; }
-    float fps() const override { return fpsEMA_ > 0 ? fpsEMA_ : static_cast<float>(targetHz_); }
     double targetHz() const override { return targetHz_; }
+    // Performance counter in microseconds (split to avoid overflowing the multiply)
+    uint32_t nowUs() const override
+    {
+        const uint64_t c = SDL_GetPerformanceCounter();
+        return static_cast<uint32_t>((c / freq_) * 1000000u + (c % freq_) * 1000000u / freq_);
+    }
+    // Leftover time as of the last pump(), as a fraction of a step
+    float alpha() const override { return static_cast<float>(Helpers::clamp(acc_ / dtSec_, 0.0, 1.0)); }
 
     void setTargetHz(double hz) override
     {
@@ -91,7 +93,6 @@ public:
     {
         nowMs_ = SDL_GetTicks();
         acc_ = 0.0;
-        fpsEMA_ = 0.0f;
     }
 
     void sleep(millis_t ms) override
@@ -0,0 +1,462 @@
+#include "FrameRecorder.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+static_assert(sizeof(Color888) == 3, "raw and PPM output write Color888 as packed RGB24");
+
+// How long the idle encoder sleeps before re-checking the ring (push() wakes it sooner)
+static constexpr int kIdleWaitMs = 5;
+
+// Streaming GIF89a writer for MATRIX_WIDTH x MATRIX_HEIGHT Color888 frames.
+//
+// A frame is held back until the next one arrives so its delay is known.
+// Identical frames only extend the delay; otherwise only the bounding box of
+// the pixels that changed is written (disposal "leave in place"). Each frame
+// carries a local 256-entry color table: panel frames rarely use more than a
+// few dozen of the 512 Color333 colors, and any beyond 256 map to the nearest.
+class FrameRecorder::GifEncoder
+{
+public:
+    GifEncoder(FILE *out, int scale) : out_(out), scale_(std::max(1, scale)) {}
+
+    void add(const Color888 *px, millis_t stampMs)
+    {
+        if (havePending_ && std::memcmp(px, pending_, sizeof(pending_)) == 0)
+            return; // same picture: the pending frame just stays up longer
+        if (havePending_)
+            writeFrame(stampMs - pendingMs_);
+        std::memcpy(pending_, px, sizeof(pending_));
+        pendingMs_ = stampMs;
+        havePending_ = true;
+    }
+
+    void finish()
+    {
+        if (!headerWritten_)
+            writeHeader(); // empty recording still yields a valid file
+        if (havePending_)
+            writeFrame(kLastFrameMs);
+        havePending_ = false;
+        std::fputc(0x3B, out_); // trailer
+    }
+
+private:
+    static constexpr millis_t kLastFrameMs = 1000;
+    static constexpr int kMinDelayCs = 2; // viewers slow down anything shorter
+    static constexpr int kMinCodeSize = 8;
+    static constexpr int kClearCode = 1 << kMinCodeSize;
+    static constexpr int kMaxCode = 4095;
+    static constexpr int kHashSize = 5003; // prime > 4096, as in classic compress
+
+    FILE *out_;
+    int scale_;
+    Color888 pending_[MATRIX_WIDTH * MATRIX_HEIGHT]{};
+    Color888 shown_[MATRIX_WIDTH * MATRIX_HEIGHT]{};
+    millis_t pendingMs_{0};
+    bool havePending_{false};
+    bool headerWritten_{false};
+    bool haveShown_{false};
+
+    // Frame palette
+    Color888 palette_[256]{};
+    int paletteSize_{0};
+    uint8_t index_[MATRIX_WIDTH * MATRIX_HEIGHT]{};
+
+    // LZW state
+    int32_t hashKeys_[kHashSize];
+    int16_t hashCodes_[kHashSize];
+    uint32_t bitBuf_{0};
+    int bitCount_{0};
+    uint8_t block_[255];
+    int blockLen_{0};
+
+    void put16(int v)
+    {
+        std::fputc(v & 0xFF, out_);
+        std::fputc((v >> 8) & 0xFF, out_);
+    }
+
+    void writeHeader()
+    {
+        std::fwrite("GIF89a", 1, 6, out_);
+        put16(MATRIX_WIDTH * scale_);
+        put16(MATRIX_HEIGHT * scale_);
+        std::fputc(0x00, out_); // no global color table
+        std::fputc(0x00, out_); // background index
+        std::fputc(0x00, out_); // square pixels
+        // NETSCAPE2.0 extension: loop forever
+        static const uint8_t loop[] = {0x21, 0xFF, 0x0B, 'N', 'E', 'T', 'S', 'C', 'A', 'P', 'E', '2', '.', '0',
+                                       0x03, 0x01, 0x00, 0x00, 0x00};
+        std::fwrite(loop, 1, sizeof(loop), out_);
+        headerWritten_ = true;
+    }
+
+    // Map every pixel of pending_ to a palette index
+    void buildPalette()
+    {
+        paletteSize_ = 0;
+        for (int i = 0; i < MATRIX_WIDTH * MATRIX_HEIGHT; ++i)
+        {
+            const Color888 c = pending_[i];
+            int best = -1;
+            for (int p = 0; p < paletteSize_; ++p)
+                if (palette_[p].r == c.r && palette_[p].g == c.g && palette_[p].b == c.b)
+                {
+                    best = p;
+                    break;
+                }
+            if (best < 0 && paletteSize_ < 256)
+            {
+                palette_[paletteSize_] = c;
+                best = paletteSize_++;
+            }
+            if (best < 0)
+                best = nearest(c);
+            index_[i] = uint8_t(best);
+        }
+    }
+
+    int nearest(Color888 c) const
+    {
+        int best = 0;
+        long bestDist = -1;
+        for (int p = 0; p < paletteSize_; ++p)
+        {
+            const long dr = long(palette_[p].r) - c.r, dg = long(palette_[p].g) - c.g, db = long(palette_[p].b) - c.b;
+            const long d = dr * dr + dg * dg + db * db;
+            if (bestDist < 0 || d < bestDist)
+            {
+                best = p;
+                bestDist = d;
+            }
+        }
+        return best;
+    }
+
+    void writeFrame(millis_t durationMs)
+    {
+        if (!headerWritten_)
+            writeHeader();
+
+        // Bounding box of what changed since the last written frame
+        int x0 = 0, y0 = 0, x1 = MATRIX_WIDTH - 1, y1 = MATRIX_HEIGHT - 1;
+        if (haveShown_)
+        {
+            x0 = MATRIX_WIDTH;
+            y0 = MATRIX_HEIGHT;
+            x1 = y1 = -1;
+            for (int y = 0; y < MATRIX_HEIGHT; ++y)
+                for (int x = 0; x < MATRIX_WIDTH; ++x)
+                {
+                    const int i = y * MATRIX_WIDTH + x;
+                    if (std::memcmp(&pending_[i], &shown_[i], sizeof(Color888)) != 0)
+                    {
+                        x0 = std::min(x0, x);
+                        x1 = std::max(x1, x);
+                        y0 = std::min(y0, y);
+                        y1 = std::max(y1, y);
+                    }
+                }
+            if (x1 < 0) // add() merges repeats, but keep the image valid regardless
+                x0 = x1 = y0 = y1 = 0;
+        }
+        std::memcpy(shown_, pending_, sizeof(shown_));
+        haveShown_ = true;
+        buildPalette();
+
+        // Graphic control extension: delay, disposal = leave in place
+        const int delayCs = std::max<int>(kMinDelayCs, int((durationMs + 5) / 10));
+        const uint8_t gce[] = {0x21, 0xF9, 0x04, 0x04};
+        std::fwrite(gce, 1, sizeof(gce), out_);
+        put16(std::min(delayCs, 0xFFFF));
+        std::fputc(0x00, out_); // no transparency
+        std::fputc(0x00, out_);
+
+        // Image descriptor with a 256-entry local color table
+        std::fputc(0x2C, out_);
+        put16(x0 * scale_);
+        put16(y0 * scale_);
+        put16((x1 - x0 + 1) * scale_);
+        put16((y1 - y0 + 1) * scale_);
+        std::fputc(0x80 | 0x07, out_);
+        for (int p = 0; p < 256; ++p)
+        {
+            const Color888 c = p < paletteSize_ ? palette_[p] : Color888{0, 0, 0};
+            const uint8_t rgb[3] = {c.r, c.g, c.b};
+            std::fwrite(rgb, 1, 3, out_);
+        }
+        writePixels(x0, y0, x1, y1);
+    }
+
+    // LZW-compress the scaled box [x0..x1] x [y0..y1] as image data sub-blocks
+    void writePixels(int x0, int y0, int x1, int y1)
+    {
+        std::fputc(kMinCodeSize, out_);
+        bitBuf_ = 0;
+        bitCount_ = 0;
+        blockLen_ = 0;
+
+        int codeSize = kMinCodeSize + 1;
+        int nextCode = kClearCode + 2;
+        resetTable();
+        putCode(kClearCode, codeSize);
+
+        int prefix = -1;
+        for (int y = y0 * scale_; y < (y1 + 1) * scale_; ++y)
+        {
+            const uint8_t *row = &index_[(y / scale_) * MATRIX_WIDTH];
+            for (int x = x0 * scale_; x < (x1 + 1) * scale_; ++x)
+            {
+                const int k = row[x / scale_];
+                if (prefix < 0)
+                {
+                    prefix = k;
+                    continue;
+                }
+                const int32_t key = (int32_t(prefix) << 8) | k;
+                int h = int(key % kHashSize);
+                while (hashKeys_[h] >= 0 && hashKeys_[h] != key)
+                    h = (h + 1) % kHashSize;
+                if (hashKeys_[h] == key)
+                {
+                    prefix = hashCodes_[h];
+                    continue;
+                }
+                putCode(prefix, codeSize);
+                if (nextCode <= kMaxCode)
+                {
+                    hashKeys_[h] = key;
+                    hashCodes_[h] = int16_t(nextCode);
+                    if (nextCode >= (1 << codeSize) && codeSize < 12)
+                        ++codeSize;
+                    ++nextCode;
+                }
+                else
+                {
+                    // Table full: start over
+                    putCode(kClearCode, codeSize);
+                    resetTable();
+                    codeSize = kMinCodeSize + 1;
+                    nextCode = kClearCode + 2;
+                }
+                prefix = k;
+            }
+        }
+        if (prefix >= 0)
+            putCode(prefix, codeSize);
+        // The decoder adds its last entry on reading that code and may widen
+        // one code earlier than we did; follow it for the final code
+        if (nextCode == (1 << codeSize) && codeSize < 12)
+            ++codeSize;
+        putCode(kClearCode + 1, codeSize); // end of information
+        if (bitCount_ > 0)
+            putByte(uint8_t(bitBuf_));
+        flushBlock();
+        std::fputc(0x00, out_); // block terminator
+    }
+
+    void resetTable()
+    {
+        std::fill(hashKeys_, hashKeys_ + kHashSize, -1);
+    }
+
+    void putCode(int code, int size)
+    {
+        bitBuf_ |= uint32_t(code) << bitCount_;
+        bitCount_ += size;
+        while (bitCount_ >= 8)
+        {
+            putByte(uint8_t(bitBuf_));
+            bitBuf_ >>= 8;
+            bitCount_ -= 8;
+        }
+    }
+
+    void putByte(uint8_t b)
+    {
+        block_[blockLen_++] = b;
+        if (blockLen_ == int(sizeof(block_)))
+            flushBlock();
+    }
+
+    void flushBlock()
+    {
+        if (!blockLen_)
+            return;
+        std::fputc(blockLen_, out_);
+        std::fwrite(block_, 1, size_t(blockLen_), out_);
+        blockLen_ = 0;
+    }
+};
+
+FrameRecorder::FrameRecorder() = default;
+
+FrameRecorder::~FrameRecorder()
+{
+    stop();
+}
+
+FrameRecorder::Format FrameRecorder::formatFor(const char *path)
+{
+    const char *dot = std::strrchr(path, '.');
+    if (dot && !std::strcmp(dot, ".gif"))
+        return Format::GIF;
+    if (dot && !std::strcmp(dot, ".ppm"))
+        return Format::PPM;
+    return Format::Raw;
+}
+
+bool FrameRecorder::start(const char *path, Format format, int slots, int gifScale)
+{
+    if (recording())
+        return false;
+    format_ = format;
+    path_ = path;
+    if (format_ == Format::PPM)
+    {
+        // path is the name of the first image; frames are numbered NAME_000000.ppm, ...
+        const std::string::size_type dot = path_.rfind(".ppm");
+        if (dot != std::string::npos && dot + 4 == path_.size())
+            path_.erase(dot);
+    }
+    else
+    {
+        out_ = std::fopen(path, "wb");
+        if (!out_)
+            return false;
+        if (format_ == Format::GIF)
+            gif_.reset(new GifEncoder(out_, gifScale));
+    }
+
+    uint32_t n = 1;
+    while (n < uint32_t(std::max(2, slots)))
+        n <<= 1;
+    ring_.reset(new Frame[n]);
+    mask_ = n - 1;
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    queued_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    written_.store(0, std::memory_order_relaxed);
+    stopping_.store(false, std::memory_order_relaxed);
+    worker_ = std::thread(&FrameRecorder::run, this);
+    return true;
+}
+
+void FrameRecorder::stop()
+{
+    if (!recording())
+        return;
+    stopping_.store(true, std::memory_order_release);
+    wake_.notify_one();
+    worker_.join();
+    ring_.reset();
+}
+
+bool FrameRecorder::push(const Color888 *fb, millis_t stampMs)
+{
+    if (!ring_ || stopping_.load(std::memory_order_relaxed))
+        return false;
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) > mask_)
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    store(head, fb, stampMs);
+    return true;
+}
+
+bool FrameRecorder::pushWait(const Color888 *fb, millis_t stampMs)
+{
+    if (!ring_ || stopping_.load(std::memory_order_relaxed))
+        return false;
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) > mask_)
+    {
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        // The timeout covers a wakeup sent between the check and the wait
+        while (head - tail_.load(std::memory_order_acquire) > mask_)
+            space_.wait_for(lock, std::chrono::milliseconds(kIdleWaitMs));
+    }
+    store(head, fb, stampMs);
+    return true;
+}
+
+// Copy a frame into slot head (known to be free) and hand it to the encoder
+void FrameRecorder::store(uint32_t head, const Color888 *fb, millis_t stampMs)
+{
+    Frame &f = ring_[head & mask_];
+    std::memcpy(f.px, fb, sizeof(f.px));
+    f.stampMs = stampMs;
+    head_.store(head + 1, std::memory_order_release);
+    queued_.fetch_add(1, std::memory_order_relaxed);
+    wake_.notify_one();
+}
+
+// Encoder thread: drain the ring, sleep when it is empty, finish on stop()
+void FrameRecorder::run()
+{
+    for (;;)
+    {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire))
+        {
+            if (stopping_.load(std::memory_order_acquire))
+            {
+                if (tail == head_.load(std::memory_order_acquire))
+                    break;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wake_.wait_for(lock, std::chrono::milliseconds(kIdleWaitMs));
+            continue;
+        }
+        encode(ring_[tail & mask_]);
+        tail_.store(tail + 1, std::memory_order_release);
+        space_.notify_one();
+    }
+    finish();
+}
+
+void FrameRecorder::encode(const Frame &f)
+{
+    switch (format_)
+    {
+    case Format::Raw:
+        std::fwrite(f.px, sizeof(Color888), kPixels, out_);
+        break;
+    case Format::PPM:
+        writePPM(f, written());
+        break;
+    case Format::GIF:
+        gif_->add(f.px, f.stampMs);
+        break;
+    }
+    written_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameRecorder::finish()
+{
+    if (gif_)
+        gif_->finish();
+    gif_.reset();
+    if (out_)
+        std::fclose(out_);
+    out_ = nullptr;
+}
+
+bool FrameRecorder::writePPM(const Frame &f, uint32_t index)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "_%06u.ppm", unsigned(index));
+    FILE *ppm = std::fopen((path_ + name).c_str(), "wb");
+    if (!ppm)
+        return false;
+    std::fprintf(ppm, "P6\n%d %d\n255\n", MATRIX_WIDTH, MATRIX_HEIGHT);
+    std::fwrite(f.px, sizeof(Color888), kPixels, ppm);
+    std::fclose(ppm);
+    return true;
+}
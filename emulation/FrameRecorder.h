@@ -0,0 +1,111 @@
+#ifndef FRAME_RECORDER_H
+#define FRAME_RECORDER_H
+
+#include "Colors.h"
+#include "Matrix32.h"
+#include "Timing.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Records presented frames to disk without slowing the frame loop.
+//
+// push() copies the Color888 framebuffer (3 KB on a 32x32 panel) into a
+// fixed ring of slots and returns; it never allocates, locks or blocks. A background thread
+// drains the ring and encodes:
+//   Raw: every frame appended as MATRIX_WIDTH*MATRIX_HEIGHT*3 bytes of RGB24
+//        (ffmpeg -f rawvideo -pixel_format rgb24 -video_size 32x32 -i FILE
+//        on the default panel)
+//   PPM: one binary P6 image per frame, NAME_000000.ppm, NAME_000001.ppm, ...
+//   GIF: one looping animated GIF, LZW-compressed, upscaled by gifScale,
+//        each frame shown until the next presented frame arrives
+// Memory is bounded by the ring size. When the encoder falls behind and the
+// ring is full, push() drops and counts new frames instead of waiting (the
+// interactive emulator must not stall). Runs with no frame budget, like the
+// headless runner, use pushWait(), which blocks for a free slot so every
+// frame is kept.
+//
+// Single producer: call push() from the thread that presents frames.
+class FrameRecorder
+{
+public:
+    enum class Format : uint8_t
+    {
+        Raw,
+        PPM,
+        GIF
+    };
+
+    static constexpr int kDefaultSlots = 64; // ~200 KB of frames in flight
+    static constexpr int kDefaultGifScale = 8;
+
+    FrameRecorder();
+    ~FrameRecorder();
+    FrameRecorder(const FrameRecorder &) = delete;
+    FrameRecorder &operator=(const FrameRecorder &) = delete;
+
+    // Pick the format from the file extension: .gif, .ppm (sequence), else raw
+    static Format formatFor(const char *path);
+
+    // Open the output and start the encoder thread; false if the file can't be opened.
+    // slots is rounded up to a power of two.
+    bool start(const char *path, Format format, int slots = kDefaultSlots, int gifScale = kDefaultGifScale);
+    // Encode what is still queued, finish the file and join the thread
+    void stop();
+    bool recording() const { return worker_.joinable(); }
+
+    // Queue one frame stamped with a time in ms; false (and counted) if the ring is full
+    bool push(const Color888 *fb, millis_t stampMs);
+    // Queue one frame, waiting for the encoder to free a slot; false only if not recording
+    bool pushWait(const Color888 *fb, millis_t stampMs);
+
+    // Frames accepted by push() / dropped because the ring was full
+    uint32_t queued() const { return queued_.load(std::memory_order_relaxed); }
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    // Frames written out by the encoder
+    uint32_t written() const { return written_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int kPixels = MATRIX_WIDTH * MATRIX_HEIGHT;
+    struct Frame
+    {
+        Color888 px[kPixels];
+        millis_t stampMs;
+    };
+    class GifEncoder;
+
+    std::unique_ptr<Frame[]> ring_;
+    uint32_t mask_{0};
+    // head_ is written only by push(), tail_ only by the encoder thread
+    std::atomic<uint32_t> head_{0};
+    std::atomic<uint32_t> tail_{0};
+    std::atomic<uint32_t> queued_{0};
+    std::atomic<uint32_t> dropped_{0};
+    std::atomic<uint32_t> written_{0};
+    std::atomic<bool> stopping_{false};
+
+    // Only used to let the threads sleep: push() wakes the encoder, the
+    // encoder wakes a pushWait() blocked on a full ring
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    std::condition_variable space_;
+    std::thread worker_;
+
+    Format format_{Format::Raw};
+    std::string path_;
+    FILE *out_{nullptr};
+    std::unique_ptr<GifEncoder> gif_;
+
+    void run();
+    void store(uint32_t head, const Color888 *fb, millis_t stampMs);
+    void encode(const Frame &f);
+    void finish();
+    bool writePPM(const Frame &f, uint32_t index);
+};
+
+#endif // FRAME_RECORDER_H
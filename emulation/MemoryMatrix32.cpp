@@ -0,0 +1,40 @@
+#include "MemoryMatrix32.h"
+#include <cstring>
+
+// Nothing to open: just start from a black frame and fresh counters
+void MemoryMatrix32::begin()
+{
+    clear();
+    presents_ = 0;
+    skipped_ = 0;
+    lastRows_ = 0;
+    drawCalls_ = 0;
+    pixelSets_ = 0;
+    fullRedraw_ = true;
+}
+
+// No display: resolve dirty rows like SDLMatrix32 and count the outcome
+void MemoryMatrix32::show()
+{
+    presentsHeld_ = false;
+    RowMask rows = 0;
+    for (int y = 0; y < MATRIX_HEIGHT; ++y)
+    {
+        const RowMask bit = RowMask(1) << y;
+        if ((fullRedraw_ || (dirtyRows_ & bit)) &&
+            std::memcmp(&fb_[y * MATRIX_WIDTH], &shown_[y * MATRIX_WIDTH], sizeof(Color888) * MATRIX_WIDTH) != 0)
+        {
+            rows |= bit;
+            std::memcpy(&shown_[y * MATRIX_WIDTH], &fb_[y * MATRIX_WIDTH], sizeof(Color888) * MATRIX_WIDTH);
+        }
+    }
+    dirtyRows_ = 0;
+    if (!rows && !fullRedraw_)
+    {
+        ++skipped_;
+        return;
+    }
+    fullRedraw_ = false;
+    lastRows_ = rows;
+    ++presents_;
+}
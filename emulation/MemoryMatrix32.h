@@ -0,0 +1,78 @@
+#ifndef MEMORY_MATRIX32_H
+#define MEMORY_MATRIX32_H
+
+#include "Color888Lut.h"
+#include "RasterMatrix32.h"
+#include <chrono>
+#include <cstdint>
+
+// Headless, RAM-only implementation of Matrix32 for the desktop emulator.
+// It keeps the same 32x32 Color888 framebuffer as SDLMatrix32 (same gamma
+// expansion) so frames can be compared byte-for-byte, but never touches SDL.
+// show() applies the same dirty-row logic as SDLMatrix32 and only counts the
+// outcome, which makes it suitable for CI, soak tests and benchmarks that run
+// scenes at full CPU speed with no display attached. It also counts draw calls
+// and single-pixel set() writes for grid-bench.
+class MemoryMatrix32 final : public RasterMatrix32<MemoryMatrix32>
+{
+public:
+    MemoryMatrix32() = default;
+    ~MemoryMatrix32() override = default;
+
+    // 32x32 RGB framebuffer (row-major)
+    Color888 fb_[MATRIX_WIDTH * MATRIX_HEIGHT]{};
+    // Convert (x,y) to framebuffer index.
+    static constexpr int coordToIndex(int x, int y) { return y * MATRIX_WIDTH + x; }
+    Color888 get(int x, int y) const { return fb_[coordToIndex(x, y)]; }
+    // Packed Color333 of pixel i (frame readback, see Canvas32::capture)
+    uint16_t codeAt(int i) const { return codeOf888(fb_[i]); }
+
+    // Reset the framebuffer and the present counter.
+    void begin() override;
+    // Set a single framebuffer pixel (bounds are NOT checked). Never presents.
+    void set(int x, int y, Color333 c) override
+    {
+        ++pixelSets_;
+        writePixel(x, y, c);
+        markRowDirty(y);
+    }
+    // Wall-clock milliseconds for the immediate-mode throttle.
+    millis_t wallMs() const
+    {
+        using namespace std::chrono;
+        return static_cast<millis_t>(duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+    // "Present" the framebuffer: counts a present if any row changed, else a skip
+    // (held presents count as neither).
+    void show() override;
+
+    // Number of frames that changed and would have been presented since begin().
+    uint32_t presents() const { return presents_; }
+    // Number of show() calls skipped because the frame was static.
+    uint32_t skippedPresents() const { return skipped_; }
+    // Rows that changed in the most recent presented frame.
+    RowMask lastPresentedRows() const { return lastRows_; }
+    // Drawing primitives (drawLine, fillRect, print, ...) completed since begin().
+    uint32_t drawCalls() const { return drawCalls_; }
+    // Single-pixel set() writes since begin().
+    uint32_t pixelSets() const { return pixelSets_; }
+
+    // RasterMatrix32 hook: end of a draw call
+    void countDrawCall() { ++drawCalls_; }
+
+    // Converts Color333 to the framebuffer color (same mapping as SDLMatrix32)
+    Color888 convertColor(Color333 c) const { return toColor888(c); }
+
+private:
+    uint32_t presents_{0}; // presented (changed) frames since begin()
+    uint32_t skipped_{0};  // static frames skipped since begin()
+    RowMask lastRows_{0};  // rows uploaded by the last present
+    uint32_t drawCalls_{0}; // completed draw calls since begin()
+    uint32_t pixelSets_{0}; // set() calls since begin()
+
+    // Last presented frame; show() compares dirty rows against it
+    Color888 shown_[MATRIX_WIDTH * MATRIX_HEIGHT]{};
+    bool fullRedraw_{true}; // next show() must present everything
+};
+
+#endif // MEMORY_MATRIX32_H
@@ -0,0 +1,23 @@
+#ifndef NULL_INPUT_PROVIDER_H
+#define NULL_INPUT_PROVIDER_H
+
+#include "Input.h"
+
+// Input provider for headless runs: the stick rests at its calibrated center
+// and the button is never pressed.
+class NullInputProvider final : public IInputProvider
+{
+public:
+    explicit NullInputProvider(const InputCalibration &c = InputCalibration{}) : IInputProvider(c) {}
+
+    void sample(InputState &out) override
+    {
+        out.x_adc = calib.x_adc_center;
+        out.y_adc = calib.y_adc_center;
+        out.pressed = false;
+        out.x = 0.0f;
+        out.y = 0.0f;
+    }
+};
+
+#endif // NULL_INPUT_PROVIDER_H
@@ -86,6 +86,7 @@ void SDLInputProvider::handleWindowEvent(const SDL_WindowEvent &we)
         // Recenter analog accumulator on focus gain
         vx = vy = 0.f;
         SDL_GetRelativeMouseState(nullptr, nullptr); // flush delta
+        snap_.mouseDx = snap_.mouseDy = 0;
     }
     else if (we.event == SDL_WINDOWEVENT_FOCUS_LOST)
     {
@@ -93,7 +94,8 @@ void SDLInputProvider::handleWindowEvent(const SDL_WindowEvent &we)
         lmbHeld = rmbHeld = false;
         vx = vy = 0.f;
     }
-    else if (we.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+    // Exposed windows need a repaint too, since static frames are no longer presented
+    else if (we.event == SDL_WINDOWEVENT_SIZE_CHANGED || we.event == SDL_WINDOWEVENT_EXPOSED)
     {
         if (resizeCb)
             resizeCb();
@@ -118,6 +120,7 @@ void SDLInputProvider::handleMouseButtonUp(const SDL_MouseButtonEvent &be)
 
 void SDLInputProvider::pumpEvents()
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     SDL_Event e;
     while (SDL_PollEvent(&e))
     {
@@ -157,14 +160,42 @@ void SDLInputProvider::pumpEvents()
             break;
         }
     }
+    takeSnapshot();
+}
+
+// Window thread, lock held: copy what sample() needs out of SDL
+void SDLInputProvider::takeSnapshot()
+{
+    snap_.ms = SDL_GetTicks();
+
+    snap_.pad = pad != nullptr;
+    snap_.padX = pad ? SDL_GameControllerGetAxis(pad, SDL_CONTROLLER_AXIS_LEFTX) : 0;
+    snap_.padY = pad ? SDL_GameControllerGetAxis(pad, SDL_CONTROLLER_AXIS_LEFTY) : 0;
+
+    // Only accumulate relative motion when LMB is held; sample() may run less
+    // often than the pump, so deltas add up until it takes them
+    if (lmbHeld)
+    {
+        int dx = 0, dy = 0;
+        SDL_GetRelativeMouseState(&dx, &dy);
+        snap_.mouseDx += dx;
+        snap_.mouseDy += dy;
+    }
+
+    snap_.left = kb && (kb[SDL_SCANCODE_A] || kb[SDL_SCANCODE_LEFT]);
+    snap_.right = kb && (kb[SDL_SCANCODE_D] || kb[SDL_SCANCODE_RIGHT]);
+    snap_.up = kb && (kb[SDL_SCANCODE_W] || kb[SDL_SCANCODE_UP]);
+    snap_.down = kb && (kb[SDL_SCANCODE_S] || kb[SDL_SCANCODE_DOWN]);
+    snap_.space = kb && kb[SDL_SCANCODE_SPACE];
 }
 
 void SDLInputProvider::sample(InputState &state)
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     state.pressed = false;
 
-    const millis_t now = SDL_GetTicks();
-    const bool padMoving = stickActive(pad);
+    const millis_t now = snap_.ms;
+    const bool padMoving = stickActive(snap_);
     const bool analogEngaged = padMoving || lmbHeld;
 
     // While in Analog, RMB acts as “button”; otherwise Space in D‑pad.
@@ -185,7 +216,7 @@ void SDLInputProvider::sample(InputState &state)
             vx = vy = 0.f; // reset mouse accumulator on exit
         }
         // In D‑pad, button is Space
-        state.pressed = (kb && kb[SDL_SCANCODE_SPACE] != 0);
+        state.pressed = snap_.space;
         genDPad(state);
     }
 }
@@ -219,13 +250,13 @@ void SDLInputProvider::genDPad(InputState &s)
 {
     // Keyboard D‑pad only. Ignore ramping for now.
     int x = 0, y = 0;
-    if (kb[SDL_SCANCODE_A] || kb[SDL_SCANCODE_LEFT])
+    if (snap_.left)
         x -= 1;
-    if (kb[SDL_SCANCODE_D] || kb[SDL_SCANCODE_RIGHT])
+    if (snap_.right)
         x += 1;
-    if (kb[SDL_SCANCODE_W] || kb[SDL_SCANCODE_UP])
+    if (snap_.up)
         y -= 1;
-    if (kb[SDL_SCANCODE_S] || kb[SDL_SCANCODE_DOWN])
+    if (snap_.down)
         y += 1;
 
     // Normalize to unit circle for diagonals
@@ -244,12 +275,12 @@ void SDLInputProvider::genDPad(InputState &s)
 
 void SDLInputProvider::useSDLAxis(float &x, float &y, bool &haveAnalog)
 {
-    if (pad)
+    if (snap_.pad)
     {
         // SDL axes are −32768..32767 → scale to [−1..1]
         const float k = InputTuning::SDL_AXIS_SCALE;
-        Sint16 ax = SDL_GameControllerGetAxis(pad, SDL_CONTROLLER_AXIS_LEFTX);
-        Sint16 ay = SDL_GameControllerGetAxis(pad, SDL_CONTROLLER_AXIS_LEFTY);
+        Sint16 ax = snap_.padX;
+        Sint16 ay = snap_.padY;
         x = Helpers::clamp(ax * k, -1.f, 1.f);
         y = Helpers::clamp(ay * k, -1.f, 1.f);
         haveAnalog = std::fabs(x) > InputTuning::EPSILON ||
@@ -259,12 +290,11 @@ void SDLInputProvider::useSDLAxis(float &x, float &y, bool &haveAnalog)
 
 void SDLInputProvider::useMouseDeltas(float &nx, float &ny, bool &haveAnalog)
 {
-    int dx = 0, dy = 0;
-
     // Only accumulate relative motion when LMB is held
     if (lmbHeld)
     {
-        SDL_GetRelativeMouseState(&dx, &dy);
+        const int dx = snap_.mouseDx, dy = snap_.mouseDy;
+        snap_.mouseDx = snap_.mouseDy = 0;
         // Velocity model: accumulate scaled deltas then decay toward center each tick.
         const float kSens = InputTuning::MOUSE_SENS;  // sensitivity px→norm
         const float decay = InputTuning::MOUSE_DECAY; // per‑tick decay (~60 Hz)
@@ -293,7 +323,7 @@ void SDLInputProvider::genAnalog(InputState &s)
     bool haveAnalog = false;
     float nx = 0.f, ny = 0.f;
 
-    if (pad)
+    if (snap_.pad)
         useSDLAxis(nx, ny, haveAnalog);
 
     // 2) If no gamepad analog, use mouse relative deltas (velocity model)
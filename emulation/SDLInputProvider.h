@@ -5,6 +5,7 @@
 #include "Input.h"
 #include "Helpers.h"
 #include <functional>
+#include <mutex>
 #include <SDL.h>
 
 // High-level input mode
@@ -57,7 +58,7 @@ class SDLInputProvider final : public IInputProvider
     // Callbacks
     std::function<void()> quitCb;      // Q or Esc
     std::function<void()> toggleLEDCb; // L
-    std::function<void()> resizeCb;    // resize window
+    std::function<void()> resizeCb;    // resize or expose window
 
     // Config
     InputMode mode = InputMode::DPad; // whether to use D‑pad or analog mode
@@ -69,6 +70,22 @@ class SDLInputProvider final : public IInputProvider
     // Mouse analog accumulator (velocity model)
     float vx = 0.f, vy = 0.f;
 
+    // Device state read by pumpEvents() at the end of each pump. sample()
+    // works from this copy only, so no SDL call runs off the window thread.
+    struct Snapshot
+    {
+        millis_t ms = 0; // SDL_GetTicks() at the pump
+        bool pad = false;
+        Sint16 padX = 0, padY = 0;
+        int mouseDx = 0, mouseDy = 0; // relative motion with LMB held, until sample() takes it
+        bool left = false, right = false, up = false, down = false, space = false;
+    };
+    Snapshot snap_;
+
+    // pumpEvents() runs on the thread that owns the window and sample() on
+    // the simulation thread; both touch the state above, so they take turns
+    std::mutex mutex_;
+
 public:
     // Experimentally determined defaults (documented)
     // deadzone: ignore |v| < 0.02; gamma: response curve exponent
@@ -88,7 +105,9 @@ public:
     void shutdown();
     ~SDLInputProvider() override { shutdown(); }
 
-    // Single SDL_PollEvent loop, handles focus/mode/buttons
+    // Single SDL_PollEvent loop, handles focus/mode/buttons, then snapshots
+    // the keyboard, mouse and gamepad for sample(). Call from the thread that
+    // owns the window; callbacks run on it with the lock held.
     void pumpEvents();
 
     // Hooks
@@ -96,7 +115,7 @@ public:
     void onToggleLED(std::function<void()> cb) { toggleLEDCb = std::move(cb); }
     void onResize(std::function<void()> cb) { resizeCb = std::move(cb); }
 
-    // Fills state based on current mode and devices
+    // Fills state based on current mode and the last snapshot (any thread)
     void sample(InputState &state) override;
 
     // Optional: toggle mode externally
@@ -112,6 +131,7 @@ private:
     void openFirstController();
     void closeController();
     void setMouseRelative(bool enabled);
+    void takeSnapshot();
 
     void clampMagnitudeToOne(float &x, float &y);
     void normalizeToUnitCircle(float &x, float &y);
@@ -141,15 +161,15 @@ private:
     }
 
     // Check if left stick is moved beyond a small threshold
-    static inline bool stickActive(SDL_GameController *pad,
+    static inline bool stickActive(const Snapshot &snap,
                                    float thresh = SDLInputProvider::PAD_MOVEMENT_THRESHOLD)
     {
-        if (!pad)
+        if (!snap.pad)
             return false;
         // Scale SDL [-32768..32767] into [-1..1]; choose 32767 so +max maps to +1.0
         const float k = InputTuning::SDL_AXIS_SCALE;
-        float ax = std::abs(SDL_GameControllerGetAxis(pad, SDL_CONTROLLER_AXIS_LEFTX) * k);
-        float ay = std::abs(SDL_GameControllerGetAxis(pad, SDL_CONTROLLER_AXIS_LEFTY) * k);
+        float ax = std::abs(snap.padX * k);
+        float ay = std::abs(snap.padY * k);
         return (ax > thresh) || (ay > thresh);
     }
 };
@@ -1,15 +1,23 @@
 #include "SDLMatrix32.h"
+#include "Trace.h"
 #include <SDL.h>
 #include <algorithm>
 #include <cstring>
 #include <stdexcept>
 
+// LED mode batches every cell into one SDL_RenderGeometry call
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+#error "SDLMatrix32 needs SDL 2.0.18 or newer (SDL_RenderGeometry)"
+#endif
+
 // ctor: create an empty object; call begin() before rendering
 SDLMatrix32::SDLMatrix32() = default;
 
 // dtor: release SDL resources safely
 SDLMatrix32::~SDLMatrix32()
 {
+    if (ledTex_)
+        SDL_DestroyTexture(ledTex_);
     if (tex_)
         SDL_DestroyTexture(tex_);
     if (ren_)
@@ -19,28 +27,13 @@ SDLMatrix32::~SDLMatrix32()
     SDL_Quit();
 }
 
-Color888 SDLMatrix32::convertColor(Color333 c)
-{
-    return Color888{expand3to8(c.r), expand3to8(c.g), expand3to8(c.b)};
-}
-
-// Convert (x,y) to framebuffer index.
-constexpr int SDLMatrix32::coordToIndex(int x, int y)
-{
-    if (x < 0 || x >= MATRIX_WIDTH || y < 0 || y >= MATRIX_HEIGHT)
-        throw std::out_of_range("SDLMatrix32 pixel out of bounds");
-
-    return y * MATRIX_WIDTH + x;
-}
-
-Color888 SDLMatrix32::get(int x, int y) const { return fb_[coordToIndex(x, y)]; }
-
 // Initialize SDL window, renderer, and streaming texture. Also compute initial scale_.
 void SDLMatrix32::begin()
 {
     if (SDL_Init(SDL_INIT_VIDEO) != 0)
         throw std::runtime_error(SDL_GetError());
-    win_ = SDL_CreateWindow("GRID-Emulator", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 320, 320, SDL_WINDOW_RESIZABLE);
+    win_ = SDL_CreateWindow("GRID-Emulator", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 10 * MATRIX_WIDTH, 10 * MATRIX_HEIGHT,
+                            SDL_WINDOW_RESIZABLE);
     if (!win_)
         throw std::runtime_error(SDL_GetError());
     ren_ = SDL_CreateRenderer(win_, -1, SDL_RENDERER_ACCELERATED);
@@ -55,104 +48,71 @@ void SDLMatrix32::begin()
     SDL_PumpEvents();
 }
 
-// Zero the framebuffer to black
-void SDLMatrix32::clear()
+// Recompute integer scale_ and LED offsets from current renderer output size
+void SDLMatrix32::recomputeScale()
 {
-    for (auto &p : fb_)
-        p = {0, 0, 0};
-}
+    int outW = 0, outH = 0;
+    SDL_GetRendererOutputSize(ren_, &outW, &outH); // HiDPI-safe
+    // Largest square cell that fits both axes (chained panels are not square)
+    scale_ = std::max(1, std::min(outW / MATRIX_WIDTH, outH / MATRIX_HEIGHT));
 
-// Set one pixel
-void SDLMatrix32::set(int x, int y, Color333 c)
-{
-    fb_[coordToIndex(x, y)] = convertColor(c);
-    if (immediate)
-        show();
-}
+    // Centered offsets for LED canvas
+    ledOffsetX_ = (outW - scale_ * MATRIX_WIDTH) / 2;
+    ledOffsetY_ = (outH - scale_ * MATRIX_HEIGHT) / 2;
 
-// Present using current render mode
-void SDLMatrix32::show()
-{
-    if (!led_mode_)
-    {
-        renderAsScreen();
-        return;
-    }
-    renderAsLEDMatrix();
+    // The drawable changed: LED quads move, and the next present() must repaint everything
+    ledQuadsValid_ = false;
+    invalidate();
 }
 
-// Draw one 5x7 glyph at (x,y), scaled by ts
-void SDLMatrix32::drawChar(int x, int y, char ch, Color333 c)
+// Logical-size scaling is a per-mode renderer setting; apply it only when it changes
+void SDLMatrix32::configureRenderer()
 {
-    const PixelMap *glyph = FONT5x7[ch - ASCII_START];
-    for (int col = 0; col < FONT_GLYPH_WIDTH; ++col)
+    if (led_mode_)
     {
-        PixelColumn bits = glyph[col];
-        for (int row = 0; row < FONT_GLYPH_HEIGHT; ++row)
-            if (bits & (1u << row))
-                drawPixelScaled(x + col, y + row, c);
+        // Turn off logical-size scaling so LED cells use real drawable pixels
+        SDL_RenderSetLogicalSize(ren_, 0, 0); // disables logical size
+        SDL_RenderSetIntegerScale(ren_, SDL_FALSE);
     }
-    if (immediate)
-        show();
-}
-
-// Alias for set()
-void SDLMatrix32::drawPixel(int x, int y, Color333 c)
-{
-    setSafe(x, y, c);
-    if (immediate)
-        show();
-}
-
-// Bresenham line
-void SDLMatrix32::drawLine(int x0, int y0, int x1, int y1, Color333 c)
-{
-    int dx = std::abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
-    int dy = -std::abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
-    int err = dx + dy;
-    while (true)
+    else
     {
-        setSafe(x0, y0, c);
-        if (x0 == x1 && y0 == y1)
-            break;
-        int e2 = 2 * err;
-        if (e2 >= dy)
-        {
-            err += dy;
-            x0 += sx;
-        }
-        if (e2 <= dx)
-        {
-            err += dx;
-            y0 += sy;
-        }
+        // Use SDL’s logical-size pipeline for crisp, centered integer scaling
+        SDL_RenderSetLogicalSize(ren_, MATRIX_WIDTH, MATRIX_HEIGHT);
+        SDL_RenderSetIntegerScale(ren_, SDL_TRUE);
     }
-    if (immediate)
-        show();
+    rendererMode_ = int(led_mode_);
 }
 
-// Rectangle outline
-void SDLMatrix32::drawRect(int x, int y, int w, int h, Color333 c)
+// Rasterize a white disc inside a black cell; per-cell color comes from vertex modulation
+void SDLMatrix32::buildLEDTexture(const LEDcell &cell)
 {
-    if (w <= 0 || h <= 0)
-        return;
-    drawHLine(x, y, w, c);
-    drawHLine(x, y + h - 1, w, c);
-    drawVLine(x, y, h, c);
-    drawVLine(x + w - 1, y, h, c);
-    if (immediate)
-        show();
-}
+    if (ledTex_)
+        SDL_DestroyTexture(ledTex_);
+    ledTex_ = SDL_CreateTexture(ren_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, cell.scale, cell.scale);
+    if (!ledTex_)
+        throw std::runtime_error(SDL_GetError());
+    SDL_SetTextureBlendMode(ledTex_, SDL_BLENDMODE_NONE);
 
-// Midpoint circle outline
-void SDLMatrix32::drawCircle(int cx, int cy, int r, Color333 c)
-{
-    if (r < 0)
-        return;
-    int x = r, y = 0, err = 1 - r;
+    // Bezel: opaque black everywhere
+    std::vector<uint32_t> px(size_t(cell.scale) * cell.scale, 0xFF000000u);
+    auto hspan = [&](int x0, int x1, int y)
+    {
+        if (y < 0 || y >= cell.scale)
+            return;
+        x0 = std::max(0, x0);
+        x1 = std::min(cell.scale - 1, x1);
+        for (int x = x0; x <= x1; ++x)
+            px[size_t(y) * cell.scale + x] = 0xFFFFFFFFu;
+    };
+    // Filled midpoint circle, same shape the per-LED renderer used to draw
+    const int c = cell.margin + cell.inner / 2;
+    int x = cell.radius, y = 0, err = 1 - cell.radius;
     while (x >= y)
     {
-        plot8(cx, cy, x, y, c);
+        hspan(c - x, c + x, c + y);
+        hspan(c - x, c + x, c - y);
+        hspan(c - y, c + y, c + x);
+        hspan(c - y, c + y, c - x);
         ++y;
         if (err < 0)
             err += 2 * y + 1;
@@ -162,252 +122,189 @@ void SDLMatrix32::drawCircle(int cx, int cy, int r, Color333 c)
             err += 2 * (y - x) + 1;
         }
     }
-    if (immediate)
-        show();
+    SDL_UpdateTexture(ledTex_, nullptr, px.data(), cell.scale * int(sizeof(uint32_t)));
+    ledTexScale_ = cell.scale;
 }
 
-// Filled rectangle
-void SDLMatrix32::fillRect(int x, int y, int w, int h, Color333 c)
+// One quad per matrix cell; only the vertex colors change from frame to frame
+void SDLMatrix32::buildLEDQuads(const LEDcell &cell)
 {
-    int x0 = std::max(0, x), y0 = std::max(0, y);
-    int x1 = std::min(MATRIX_WIDTH - 1, x + w - 1), y1 = std::min(MATRIX_HEIGHT - 1, y + h - 1);
-    for (int yy = y0; yy <= y1; ++yy)
-        for (int xx = x0; xx <= x1; ++xx)
-            setSafe(xx, yy, c);
-    if (immediate)
-        show();
-}
-
-// Filled circle via spans
-void SDLMatrix32::fillCircle(int cx, int cy, int r, Color333 c)
-{
-    if (r < 0)
-        return;
-    int x = r, y = 0, err = 1 - r;
-    while (x >= y)
+    const int cells = MATRIX_WIDTH * MATRIX_HEIGHT;
+    ledVerts_.resize(size_t(cells) * 4);
+    ledIndices_.resize(size_t(cells) * 6);
+    for (int y = 0; y < MATRIX_HEIGHT; ++y)
     {
-        span(cx - x, cx + x, cy + y, c);
-        span(cx - x, cx + x, cy - y, c);
-        span(cx - y, cx + y, cy + x, c);
-        span(cx - y, cx + y, cy - x, c);
-        ++y;
-        if (err < 0)
-            err += 2 * y + 1;
-        else
+        for (int x = 0; x < MATRIX_WIDTH; ++x)
         {
-            --x;
-            err += 2 * (y - x) + 1;
+            const int i = coordToIndex(x, y);
+            const float sx = float(ledOffsetX_ + x * cell.scale);
+            const float sy = float(ledOffsetY_ + y * cell.scale);
+            const float s = float(cell.scale);
+            SDL_Vertex *v = &ledVerts_[size_t(i) * 4];
+            v[0].position = {sx, sy};
+            v[0].tex_coord = {0.f, 0.f};
+            v[1].position = {sx + s, sy};
+            v[1].tex_coord = {1.f, 0.f};
+            v[2].position = {sx + s, sy + s};
+            v[2].tex_coord = {1.f, 1.f};
+            v[3].position = {sx, sy + s};
+            v[3].tex_coord = {0.f, 1.f};
+            int *idx = &ledIndices_[size_t(i) * 6];
+            const int base = i * 4;
+            idx[0] = base;
+            idx[1] = base + 1;
+            idx[2] = base + 2;
+            idx[3] = base;
+            idx[4] = base + 2;
+            idx[5] = base + 3;
         }
     }
-    if (immediate)
-        show();
+    ledQuadsValid_ = true;
 }
 
-// Move cursor by 1 glyph (5px + 1px spacing) at current scale
-void SDLMatrix32::advance() { cx += ts * FONT_CHAR_WIDTH; }
-
-// Set text cursor
-void SDLMatrix32::setCursor(int x, int y)
+// Render a whole frame as LEDs in one batched submission
+void SDLMatrix32::renderAsLEDMatrix(const Color888 *px)
 {
-    cx = x;
-    cy = y;
-    lineStartX = x;
-}
-
-// Set text color
-void SDLMatrix32::setTextColor(Color333 c) { tc = c; }
-
-// Set integer text scale >= 1
-void SDLMatrix32::setTextSize(int s) { ts = std::max(1, s); }
+    const LEDcell cell = makeLEDcell();
+    if (ledTexScale_ != cell.scale)
+        buildLEDTexture(cell);
+    if (!ledQuadsValid_)
+        buildLEDQuads(cell);
 
-// Print a single character (handles newline)
-void SDLMatrix32::print(char ch)
-{
-    if (ch == '\n')
-    {
-        cx = lineStartX;
-        cy += ts * (FONT_CHAR_HEIGHT + 1);
-        return;
-    }
-    if (ch < ASCII_START)
+    SDL_SetRenderDrawColor(ren_, 0, 0, 0, 255);
+    SDL_RenderClear(ren_);
+    for (int i = 0; i < MATRIX_WIDTH * MATRIX_HEIGHT; ++i)
     {
-        advance();
-        return;
+        // Color from the frame (dim "off" LED for dome look)
+        const Color888 pix = px[i];
+        const bool off = (pix.r | pix.g | pix.b) == 0;
+        const SDL_Color col = off ? SDL_Color{12, 12, 12, 255} : SDL_Color{pix.r, pix.g, pix.b, 255};
+        SDL_Vertex *v = &ledVerts_[size_t(i) * 4];
+        v[0].color = v[1].color = v[2].color = v[3].color = col;
     }
-    drawChar(cx, cy, ch, tc);
-    advance();
-}
-
-// Print a C string
-void SDLMatrix32::print(const char *s)
-{
-    for (const char *p = s; *p; ++p)
-        print(*p);
-}
-
-// Print a C string then newline
-void SDLMatrix32::println(const char *s)
-{
-    print(s);
-    print('\n');
-}
-
-// Minimal helper: recompute integer scale_ from current renderer output size
-void SDLMatrix32::recomputeScale()
-{
-    int outW = 0, outH = 0;
-    SDL_GetRendererOutputSize(ren_, &outW, &outH); // HiDPI-safe
-    const int square = std::min(outW, outH);
-    scale_ = std::max(1, square / MATRIX_WIDTH);
-
-    // Centered offsets for LED canvas
-    const int canvas = scale_ * MATRIX_WIDTH;
-    ledOffsetX_ = (outW - canvas) / 2;
-    ledOffsetY_ = (outH - canvas) / 2;
-}
-
-// Render one matrix pixel as a circular LED inside a black cell
-void SDLMatrix32::renderPixelAsLED(int x, int y, const LEDcell &cell)
-{
-    const int sx = ledOffsetX_ + x * cell.scale;
-    const int sy = ledOffsetY_ + y * cell.scale;
-
-    // Bezel
-    SetRGBA(ren_, 0, 0, 0, 255);
-    SDL_Rect cellRect{sx, sy, cell.scale, cell.scale};
-    SDL_RenderFillRect(ren_, &cellRect);
-
-    // Center of LED
-    const int cx_led = sx + cell.margin + cell.inner / 2;
-    const int cy_led = sy + cell.margin + cell.inner / 2;
-
-    // Color from framebuffer (dim "off" LED for dome look)
-    const auto pix = fb_[coordToIndex(x, y)];
-
-    Intensity8 r = pix.r, g = pix.g, b = pix.b;
-    if ((r | g | b) == 0)
-        r = g = b = 12;
-    SetRGBA(ren_, r, g, b, 255);
-
-    // Filled circle
-    drawLEDAsCircle(ren_, cx_led, cy_led, cell.radius);
-}
-
-// Render the whole framebuffer as LEDs
-void SDLMatrix32::renderAsLEDMatrix()
-{
-    // Turn off logical-size scaling so LED cells use real drawable pixels
-    SDL_RenderSetLogicalSize(ren_, 0, 0); // disables logical size
-    SDL_RenderSetIntegerScale(ren_, SDL_FALSE);
-
-    // Make sure our integer scale_ and offsets are based on drawable size
-    recomputeScale(); // also recomputeOffsets() if you followed earlier step
-
-    SDL_RenderClear(ren_);
-    SetRGBA(ren_, 0, 0, 0, 255);
-    const LEDcell cell = makeLEDcell();
-    for (int y = 0; y < MATRIX_HEIGHT; ++y)
-        for (int x = 0; x < MATRIX_WIDTH; ++x)
-            renderPixelAsLED(x, y, cell);
+    SDL_RenderGeometry(ren_, ledTex_, ledVerts_.data(), int(ledVerts_.size()),
+                       ledIndices_.data(), int(ledIndices_.size()));
     SDL_RenderPresent(ren_);
 }
 
-// Render the whole framebuffer as a 32x32 texture
-void SDLMatrix32::renderAsScreen()
+// Render a frame as a MATRIX_WIDTH x MATRIX_HEIGHT texture, uploading only the given rows
+void SDLMatrix32::renderAsScreen(const Color888 *px, RowMask rows)
 {
-    // Use SDL’s logical-size pipeline for crisp, centered integer scaling
-    SDL_RenderSetLogicalSize(ren_, MATRIX_WIDTH, MATRIX_HEIGHT);
-    SDL_RenderSetIntegerScale(ren_, SDL_TRUE);
-    void *pixels = nullptr;
-    int pitch = 0;
-    if (SDL_LockTexture(tex_, nullptr, &pixels, &pitch) == 0)
+    // Logical size is set by configureRenderer() when the mode changes
+    // Upload each contiguous run of changed rows with one texture update
+    const int width = MATRIX_WIDTH, bpp = 3;
+    int y = 0;
+    while (y < MATRIX_HEIGHT)
     {
-        auto *dst = static_cast<uint8_t *>(pixels);
-        const int width = MATRIX_WIDTH, height = MATRIX_HEIGHT, bpp = 3;
-        for (int y = 0; y < height; ++y)
+        if (!(rows & (RowMask(1) << y)))
         {
-            const uint8_t *src_row = reinterpret_cast<const uint8_t *>(&fb_[y * width]);
-            std::memcpy(dst + y * pitch, src_row, width * bpp);
+            ++y;
+            continue;
         }
-        SDL_UnlockTexture(tex_);
+        const int runStart = y;
+        while (y < MATRIX_HEIGHT && (rows & (RowMask(1) << y)))
+            ++y;
+        const SDL_Rect band{0, runStart, width, y - runStart};
+        SDL_UpdateTexture(tex_, &band, &px[runStart * width], width * bpp);
     }
     SDL_RenderClear(ren_);
     SDL_RenderCopy(ren_, tex_, nullptr, nullptr); // NULL dst uses logical size
     SDL_RenderPresent(ren_);
 }
 
-// Draw a clamped horizontal span of pixels in the framebuffer
-void SDLMatrix32::span(int x0, int x1, int y, Color333 c)
+// Publish the frame to the render thread; static frames are skipped
+void SDLMatrix32::show()
 {
-    if (y < 0 || y >= MATRIX_HEIGHT)
-        return;
-    x0 = std::max(0, x0);
-    x1 = std::min(MATRIX_WIDTH - 1, x1);
-    for (int x = x0; x <= x1; ++x)
-        setSafe(x, y, c);
-}
+    presentsHeld_ = false;
+    offered_.fetch_add(1, std::memory_order_relaxed);
+    const RowMask rows = resolveDirtyRows();
+    if (!rows)
+        return; // nothing changed since the last published frame
 
-// Draw a horizontal line in the framebuffer
-void SDLMatrix32::drawHLine(int x, int y, int w, Color333 c)
-{
-    for (int i = 0; i < w; ++i)
-        setSafe(x + i, y, c);
+    // Remember what was published for the next comparison
+    for (int y = 0; y < MATRIX_HEIGHT; ++y)
+        if (rows & (RowMask(1) << y))
+            std::memcpy(&shown_[y * MATRIX_WIDTH], &fb_[y * MATRIX_WIDTH], sizeof(Color888) * MATRIX_WIDTH);
+
+    std::memcpy(frames_.back().px, fb_, sizeof fb_);
+    if (frames_.publish())
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    published_.fetch_add(1, std::memory_order_relaxed);
+
+    if (recorder_)
+        recorder_->push(fb_, SDL_GetTicks()); // copies and returns; drops if the encoder lags
 }
 
-// Draw a vertical line in the framebuffer
-void SDLMatrix32::drawVLine(int x, int y, int h, Color333 c)
+// Draw the newest published frame using the current render mode
+bool SDLMatrix32::present()
 {
-    for (int i = 0; i < h; ++i)
-        setSafe(x, y + i, c);
+    GRID_TRACE_SCOPE("present", "display");
+    const bool fresh = frames_.acquire();
+    // No frame at all from the simulation since the last refresh: the display repeats one
+    const uint32_t offered = offered_.load(std::memory_order_relaxed);
+    if (offered == offeredSeen_)
+        duplicated_.fetch_add(1, std::memory_order_relaxed);
+    offeredSeen_ = offered;
+
+    if (!fresh && !fullRedraw_)
+        return false;
+    const Color888 *px = frames_.front().px;
+    const RowMask rows = fullRedraw_ ? kAllRows : changedRows(px);
+    if (!rows)
+        return false;
+    if (rendererMode_ != int(led_mode_))
+        configureRenderer();
+    fullRedraw_ = false;
+
+    if (!led_mode_)
+        renderAsScreen(px, rows);
+    else
+        renderAsLEDMatrix(px);
+    presented_.fetch_add(1, std::memory_order_relaxed);
+
+    for (int y = 0; y < MATRIX_HEIGHT; ++y)
+        if (rows & (RowMask(1) << y))
+            std::memcpy(&onScreen_[y * MATRIX_WIDTH], &px[y * MATRIX_WIDTH], sizeof(Color888) * MATRIX_WIDTH);
+    return true;
 }
 
-// Plot using 8-way symmetry for circle algorithms
-void SDLMatrix32::plot8(int cx, int cy, int x, int y, Color333 c)
+int SDLMatrix32::displayHz() const
 {
-    setSafe(cx + x, cy + y, c);
-    setSafe(cx - x, cy + y, c);
-    setSafe(cx + x, cy - y, c);
-    setSafe(cx - x, cy - y, c);
-    setSafe(cx + y, cy + x, c);
-    setSafe(cx - y, cy + x, c);
-    setSafe(cx + y, cy - x, c);
-    setSafe(cx - y, cy - x, c);
+    SDL_DisplayMode mode;
+    if (SDL_GetWindowDisplayMode(win_, &mode) == 0 && mode.refresh_rate > 0)
+        return mode.refresh_rate;
+    return 60;
 }
 
-// Draw a ts x ts block at logical (x,y)
-void SDLMatrix32::drawPixelScaled(int x, int y, Color333 c)
+FrameStats SDLMatrix32::frameStats() const
 {
-    for (int dy = 0; dy < ts; ++dy)
-        for (int dx = 0; dx < ts; ++dx)
-            setSafe(x * ts + dx, y * ts + dy, c);
+    return FrameStats{published_.load(std::memory_order_relaxed), dropped_.load(std::memory_order_relaxed),
+                      presented_.load(std::memory_order_relaxed), duplicated_.load(std::memory_order_relaxed)};
 }
 
-// Set renderer draw color (RGBA)
-inline void SDLMatrix32::SetRGBA(SDL_Renderer *r, Intensity8 r8, Intensity8 g8, Intensity8 b8, Intensity8 a)
+// Rows of a newly acquired frame that differ from what is on screen
+RowMask SDLMatrix32::changedRows(const Color888 *px) const
 {
-    SDL_SetRenderDrawColor(r, r8, g8, b8, a);
+    RowMask changed = 0;
+    for (int y = 0; y < MATRIX_HEIGHT; ++y)
+        if (std::memcmp(&px[y * MATRIX_WIDTH], &onScreen_[y * MATRIX_WIDTH], sizeof(Color888) * MATRIX_WIDTH) != 0)
+            changed |= RowMask(1) << y;
+    return changed;
 }
 
-// Draw a filled circle via horizontal spans on the SDL renderer
-static inline void HSpan(SDL_Renderer *ren, int x0, int x1, int y) { SDL_RenderDrawLine(ren, x0, y, x1, y); }
-void SDLMatrix32::drawLEDAsCircle(SDL_Renderer *ren, int cx, int cy, int r)
+// Compare each dirty row with the last published frame and keep only real changes
+RowMask SDLMatrix32::resolveDirtyRows()
 {
-    int x = r, y = 0, err = 1 - r;
-    while (x >= y)
+    RowMask changed = 0;
+    for (int y = 0; y < MATRIX_HEIGHT; ++y)
     {
-        HSpan(ren, cx - x, cx + x, cy + y);
-        HSpan(ren, cx - x, cx + x, cy - y);
-        HSpan(ren, cx - y, cx + y, cy + x);
-        HSpan(ren, cx - y, cx + y, cy - x);
-        ++y;
-        if (err < 0)
-            err += 2 * y + 1;
-        else
-        {
-            --x;
-            err += 2 * (y - x) + 1;
-        }
+        const RowMask bit = RowMask(1) << y;
+        if ((dirtyRows_ & bit) &&
+            std::memcmp(&fb_[y * MATRIX_WIDTH], &shown_[y * MATRIX_WIDTH], sizeof(Color888) * MATRIX_WIDTH) != 0)
+            changed |= bit;
     }
+    dirtyRows_ = 0;
+    return changed;
 }
 
 // Build LEDcell parameters from current scale and styling constants
@@ -421,29 +318,3 @@ LEDcell SDLMatrix32::makeLEDcell() const
     cell.radius = std::max(1, int(0.5f * cell.inner * cell.fill));
     return cell;
 }
-
-/*
-Mapping 3-bit intensities (0..7) to 8-bit (0..255) using a perceptual curve.
-
-Background:
-- A linear map (v * 255 / 7) looks too dim at low codes in emulation compared
-  to real LEDs. Human brightness perception is non-linear, so we apply an
-  inverse‑gamma curve to brighten lows.
-
-How this LUT was computed:
-1) Choose a target for v=1 in 8-bit space (Y1). Here we use Y1 = 150.
-2) Solve for the curve exponent (gamma_inv) that hits that anchor:
-     gamma_inv = ln(Y1 / 255) / ln(1 / 7)
-3) For each v in [0..7], compute:
-     LUT[v] = round( (v / 7)^gamma_inv * 255 )
-   with hard anchors LUT[0] = 0 and LUT[7] = 255.
-
-Notes:
-- This keeps v=7 at full scale while making v=1 “noticeably bright”.
-- If highlights feel too hot, increase Y1? No—decrease it (or clamp results).
-  If lows are still dull, increase Y1.
-- Regenerate the table by changing Y1 and re-running the formula above.
-*/
-// v: 0..7  ->  0..255 with inverse-gamma to brighten low codes
-const Intensity8 SDLMatrix32::kExpand3to8Gamma[8] =
-    {0, 150, 181, 202, 220, 233, 245, 255};
@@ -1,13 +1,19 @@
 #ifndef SDL_MATRIX32_H
 #define SDL_MATRIX32_H
 
-#include "Matrix32.h"
+#include "Color888Lut.h"
+#include "FrameRecorder.h"
 #include "Helpers.h"
+#include "RasterMatrix32.h"
+#include "TripleBuffer.h"
+#include <atomic>
 #include <cstdint>
+#include <vector>
 
 struct SDL_Window;
 struct SDL_Renderer;
 struct SDL_Texture;
+struct SDL_Vertex;
 
 // Parameters that control how each logical LED cell is rendered on screen.
 // - scale:  number of screen pixels per 1 matrix pixel
@@ -24,11 +30,31 @@ struct LEDcell
     int radius;
 };
 
+// Frame handoff counters since begin(), see SDLMatrix32::frameStats()
+struct FrameStats
+{
+    uint32_t published;  // changed frames handed to the render thread
+    uint32_t dropped;    // published frames replaced before the render thread took them
+    uint32_t presented;  // frames the render thread put on screen
+    uint32_t duplicated; // display refreshes with no new simulation frame at all
+};
+
 // SDL-backed implementation of Matrix32 for the desktop emulator.
+//
+// Drawing and presenting run on different threads. The simulation thread
+// draws into fb_ and calls show(), which publishes a snapshot of each changed
+// frame through a lock-free triple buffer and never touches SDL rendering.
+// The thread that called begin() owns the window and renderer (SDL's
+// threading rule) and calls present() at display rate to put the newest
+// snapshot on screen, so a slow present no longer eats into the fixed step.
+//
 // It supports two render modes:
-// 1) Screen mode: fast blit of a 32x32 RGB texture
-// 2) LED mode:    each pixel is drawn as a small colored circle in a black cell
-class SDLMatrix32 : public Matrix32
+// 1) Screen mode: fast blit of a MATRIX_WIDTH x MATRIX_HEIGHT RGB texture
+// 2) LED mode:    each pixel is drawn as a small colored circle in a black cell.
+//                 One white LED-disc texture is rasterized per window scale and
+//                 all cells are submitted as color-modulated quads in a
+//                 single SDL_RenderGeometry call (needs SDL 2.0.18 or newer).
+class SDLMatrix32 final : public RasterMatrix32<SDLMatrix32>
 {
 public:
     // Construct an uninitialized instance. Call begin() before use.
@@ -36,116 +62,126 @@ public:
     // Destroys SDL resources (texture, renderer, window) and quits SDL.
     ~SDLMatrix32() override;
 
-    // 32x32 RGB framebuffer (row-major)
+    // RGB framebuffer (row-major), drawn by the simulation thread
     Color888 fb_[MATRIX_WIDTH * MATRIX_HEIGHT]{};
     // Convert (x,y) to framebuffer index.
-    static constexpr int coordToIndex(int x, int y);
-    Color888 get(int x, int y) const;
+    static constexpr int coordToIndex(int x, int y) { return y * MATRIX_WIDTH + x; }
+    Color888 get(int x, int y) const { return fb_[coordToIndex(x, y)]; }
+    // Packed Color333 of pixel i (frame readback, see Canvas32::capture)
+    uint16_t codeAt(int i) const { return codeOf888(fb_[i]); }
 
     // Initialize SDL window, renderer, streaming texture, and compute initial scale.
     void begin() override;
     // Get the underlying SDL_Window (for input provider).
     SDL_Window *window() const { return win_; }
-    // Clear the 32x32 framebuffer to black.
-    void clear() override;
-    // Set a single framebuffer pixel (bounds-checked).
-    void set(int x, int y, Color333 c) override;
-    // Present the framebuffer using the current render mode (screen or LED).
+    // Set a single framebuffer pixel (bounds are NOT checked). Never presents.
+    void set(int x, int y, Color333 c) override
+    {
+        writePixel(x, y, c);
+        markRowDirty(y);
+    }
+    // Wall-clock milliseconds for the immediate-mode throttle.
+    millis_t wallMs() const { return SDL_GetTicks(); }
+    // Simulation thread: publish the framebuffer to the render thread.
+    // Skips the handoff entirely when no row changed since the last one.
     void show() override;
+    // Hand every published frame to rec (nullptr stops); rec must outlive its use here.
+    void setRecorder(FrameRecorder *rec) { recorder_ = rec; }
+
+    // Render thread (the one that called begin()): draw the newest published
+    // frame in the current render mode. Call once per display refresh; returns
+    // false when there was nothing new to present.
+    bool present();
+    // Render thread: refresh rate of the window's display (60 if unknown)
+    int displayHz() const;
+    // Force the next present() to upload and present the full frame.
+    void invalidate() { fullRedraw_ = true; }
+    // Handoff counters; safe to read from either thread
+    FrameStats frameStats() const;
 
     // Toggle LED rendering mode.
-    void toggleLEDMode() { led_mode_ = !led_mode_; }
-
-    // Draw a 5x7 glyph scaled by setTextSize() at (x,y).
-    void drawChar(int x, int y, char ch, Color333 c) override;
-    // Set one pixel (alias for set()).
-    void drawPixel(int x, int y, Color333 c) override;
-    // Draw a line using Bresenham.
-    void drawLine(int x0, int y0, int x1, int y1, Color333 c) override;
-    // Draw an axis-aligned rectangle outline.
-    void drawRect(int x, int y, int w, int h, Color333 c) override;
-    // Draw a circle outline using the midpoint algorithm.
-    void drawCircle(int cx, int cy, int r, Color333 c) override;
-    // Fill an axis-aligned rectangle.
-    void fillRect(int x, int y, int w, int h, Color333 c) override;
-    // Fill a circle using horizontal spans.
-    void fillCircle(int cx, int cy, int r, Color333 c) override;
-
-    // Advance the text cursor by one glyph (including 1px spacing).
-    void advance() override;
-    // Set text cursor position in pixels.
-    void setCursor(int x, int y) override;
-    // Set text color for print/drawChar.
-    void setTextColor(Color333 c) override;
-    // Set integer text scale >= 1.
-    void setTextSize(int s) override;
-    // Print a single character (handles '\n').
-    void print(char ch) override;
-    // Print a C string.
-    void print(const char *s) override;
-    // Print a C string followed by newline.
-    void println(const char *s) override;
+    void toggleLEDMode()
+    {
+        led_mode_ = !led_mode_;
+        invalidate();
+    }
 
     // Enable or query LED rendering mode.
-    void setLEDMode(bool on) { led_mode_ = on; }
+    void setLEDMode(bool on)
+    {
+        led_mode_ = on;
+        invalidate();
+    }
     bool ledMode() const { return led_mode_; }
 
-    // Minimal helper: recompute integer scale_ from current renderer output size
+    // Recompute integer scale_ and LED offsets from the current renderer output size.
+    // Call on resize; the LED texture and quads are rebuilt lazily when they change.
     void recomputeScale();
 
-    // Render one matrix pixel as an LED circle into the SDL renderer.
-    void renderPixelAsLED(int x, int y, const LEDcell &cell);
-    // Render the entire framebuffer as an LED matrix.
-    void renderAsLEDMatrix();
-    // Render the entire framebuffer as a blocky 32x32 screen.
-    void renderAsScreen();
+    // Render a frame as an LED matrix.
+    void renderAsLEDMatrix(const Color888 *px);
+    // Render a frame as a blocky screen, uploading only the given rows.
+    void renderAsScreen(const Color888 *px, RowMask rows);
 
-    // Converts Color333 to PixelColor
-    Color888 convertColor(Color333 c);
+    // Converts Color333 to PixelColor (per-channel gamma curve, see Color888Lut.h)
+    Color888 convertColor(Color333 c) const { return toColor888(c); }
 
 private:
-    // Text state
-    int cx{0};                      // cursor x in pixels
-    int cy{0};                      // cursor y in pixels
-    int lineStartX{0};              // start-of-line x for newline handling
-    int ts{1};                      // text scale
-    Color333 tc{Color333{7, 7, 7}}; // text color
-
     // SDL state
     SDL_Window *win_{};
     SDL_Renderer *ren_{};
     SDL_Texture *tex_{};
 
+    // Simulation side: last published frame; show() compares dirty rows against it
+    Color888 shown_[MATRIX_WIDTH * MATRIX_HEIGHT]{};
+    FrameRecorder *recorder_{nullptr}; // optional capture of published frames
+
+    // Handoff: one whole frame per slot (3 KB each on a 32x32 panel)
+    struct Frame
+    {
+        Color888 px[MATRIX_WIDTH * MATRIX_HEIGHT];
+    };
+    TripleBuffer<Frame> frames_;
+    std::atomic<uint32_t> offered_{0}; // show() calls, changed or not
+    std::atomic<uint32_t> published_{0};
+    std::atomic<uint32_t> dropped_{0};
+    std::atomic<uint32_t> presented_{0};
+    std::atomic<uint32_t> duplicated_{0};
+
+    // Render side: what the texture/window currently shows
+    Color888 onScreen_[MATRIX_WIDTH * MATRIX_HEIGHT]{};
+    uint32_t offeredSeen_{0}; // offered_ at the previous present()
+    bool fullRedraw_{true}; // next present() must draw everything (resize, mode switch)
+
     // Rendering options
     bool led_mode_{false};
     int scale_{16}; // screen pixels per logical LED
     int ledOffsetX_{0};
     int ledOffsetY_{0};
+    int rendererMode_{-1}; // led_mode_ the renderer is configured for (-1 = not yet)
 
-    // Low-level framebuffer helpers
-    void span(int x0, int x1, int y, Color333 c); // clamped horizontal span
-    void drawHLine(int x, int y, int w, Color333 c);
-    void drawVLine(int x, int y, int h, Color333 c);
-    void plot8(int cx, int cy, int x, int y, Color333 c); // 8-way circle symmetry plot
-    void drawPixelScaled(int x, int y, Color333 c);       // draw ts x ts block
+    // LED-mode cache: one disc texture per scale plus a quad per cell
+    SDL_Texture *ledTex_{};
+    int ledTexScale_{0};             // scale the disc texture was built for (0 = none)
+    bool ledQuadsValid_{false};      // ledVerts_ positions match scale_/offsets
+    std::vector<SDL_Vertex> ledVerts_; // 4 vertices per cell, colors refreshed per frame
+    std::vector<int> ledIndices_;      // 6 indices per cell (two triangles)
 
     // SDL helpers
-    static inline void SetRGBA(SDL_Renderer *r, Intensity3 r8, Intensity3 g8, Intensity8 b8, Intensity8 a = 255);
-    static void drawLEDAsCircle(SDL_Renderer *ren, int cx, int cy, int r);
+    // Apply logical-size settings for the active render mode (only on mode changes).
+    void configureRenderer();
+    // Rasterize the white LED disc on a black cell into ledTex_ for the current scale.
+    void buildLEDTexture(const LEDcell &cell);
+    // Lay out one textured quad per matrix cell for the current scale and offsets.
+    void buildLEDQuads(const LEDcell &cell);
 
     // Build LEDcell from current scale and chosen styling.
     LEDcell makeLEDcell() const;
 
-    // v: 0..7  ->  0..255 with inverse-gamma to brighten low codes
-    static const Intensity8 kExpand3to8Gamma[8];
-
-    // Converts 0..7 -> 0..255 with rounding
-    Intensity8 expand3to8(Intensity3 v)
-    {
-        // Adding half the divisor before dividing performs round‑to‑nearest: floor((v × 255 + 7/2) / 7)
-        // Since we can’t add 3.5 in integers, we use +3 as a close, deterministic half
-        return kExpand3to8Gamma[v & 0x7];
-        }
+    // Drop dirty rows whose contents match shown_; returns rows that really changed.
+    RowMask resolveDirtyRows();
+    // Rows of px that differ from onScreen_
+    RowMask changedRows(const Color888 *px) const;
 };
 
 #endif // SDL_MATRIX32_H
@@ -0,0 +1,66 @@
+#ifndef SCRIPTED_INPUT_PROVIDER_H
+#define SCRIPTED_INPUT_PROVIDER_H
+
+#include "Input.h"
+#include <cstddef>
+#include <cstdint>
+
+// Input provider that replays a fixed script, for benchmarks and other
+// repeatable runs. Each step holds the stick at (x, y) (-1..+1, +y down, as
+// the D-pad in SDLInputProvider) and the button for a number of samples; the
+// script starts over when it runs out. An empty script rests at center.
+class ScriptedInputProvider final : public IInputProvider
+{
+public:
+    struct Step
+    {
+        uint16_t samples; // how many sample() calls this step lasts
+        float x;
+        float y;
+        bool pressed;
+    };
+
+    ScriptedInputProvider(const Step *steps, size_t count, const InputCalibration &c = InputCalibration{})
+        : IInputProvider(c), steps_(steps), count_(count) {}
+
+    void sample(InputState &out) override
+    {
+        Step s{1, 0.0f, 0.0f, false};
+        if (count_)
+        {
+            s = steps_[index_];
+            if (++held_ >= s.samples)
+            {
+                held_ = 0;
+                index_ = (index_ + 1) % count_;
+            }
+        }
+        out.x_adc = toADC(s.x, calib.x_adc_low, calib.x_adc_center, calib.x_adc_high);
+        out.y_adc = toADC(s.y, calib.y_adc_low, calib.y_adc_center, calib.y_adc_high);
+        out.pressed = s.pressed;
+        out.x = s.x;
+        out.y = s.y;
+    }
+
+    // Start the script over
+    void rewind()
+    {
+        index_ = 0;
+        held_ = 0;
+    }
+
+private:
+    const Step *steps_;
+    size_t count_;
+    size_t index_ = 0;
+    uint16_t held_ = 0;
+
+    // Inverse of Input::toNorm: -1 -> low, 0 -> center, +1 -> high
+    static AnalogInput_t toADC(float v, AnalogInput_t low, AnalogInput_t center, AnalogInput_t high)
+    {
+        const float adc = v < 0.0f ? center + v * (center - low) : center + v * (high - center);
+        return static_cast<AnalogInput_t>(adc + 0.5f);
+    }
+};
+
+#endif // SCRIPTED_INPUT_PROVIDER_H
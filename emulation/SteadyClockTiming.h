@@ -0,0 +1,62 @@
+#ifndef STEADY_CLOCK_TIMING_H
+#define STEADY_CLOCK_TIMING_H
+
+#include "Timing.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+/**
+ * @brief SDL-free Timing for headless runs.
+ *
+ * Reflects std::chrono::steady_clock like ArduinoPassiveTiming reflects millis():
+ * a nominal dt derived from targetHz and no cadence control, so the caller can
+ * step scenes as fast as the CPU allows.
+ */
+class SteadyClockTiming final : public Timing
+{
+    using clock = std::chrono::steady_clock;
+
+    const double defaultTargetHz_{60.0};
+    double targetHz_;
+    float dtMs_;
+    clock::time_point start_;
+
+public:
+    explicit SteadyClockTiming(double targetHz)
+        : defaultTargetHz_(targetHz), targetHz_(targetHz),
+          dtMs_(static_cast<float>(MILLIS_PER_SEC / targetHz)),
+          start_(clock::now()) {}
+
+    millis_t nowMs() const override
+    {
+        return static_cast<millis_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - start_).count());
+    }
+    float dtMs() const override { return dtMs_; } // nominal
+    double targetHz() const override { return targetHz_; }
+
+    void setTargetHz(double hz) override
+    {
+        targetHz_ = hz;
+        dtMs_ = static_cast<float>(MILLIS_PER_SEC / targetHz_);
+    }
+
+    // When there is a preferred timing, apply it; otherwise use default
+    void applyPreference(SceneTimingPrefs pref) override
+    {
+        if (std::isnan(pref.targetHz))
+            setTargetHz(defaultTargetHz_);
+        else
+            setTargetHz(pref.targetHz);
+    }
+
+    void resetSceneClock() override { start_ = clock::now(); }
+
+    void sleep(millis_t ms) override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    }
+};
+
+#endif // STEADY_CLOCK_TIMING_H
@@ -0,0 +1,196 @@
+#include "Trace.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Trace
+{
+namespace detail
+{
+std::atomic<bool> active{false};
+}
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct Event
+{
+    const char *name;
+    const char *cat;
+    int64_t ns; // since start()
+    char ph;    // 'B', 'E' or 'i'
+};
+
+// One thread's events. Only its owner writes; count is released after each
+// event so stop() can read everything below it from another thread.
+struct Buffer
+{
+    std::unique_ptr<Event[]> events;
+    size_t capacity;
+    std::atomic<size_t> count{0};
+    std::atomic<const char *> threadName{nullptr};
+    unsigned tid;
+    unsigned session;
+};
+
+struct ThreadState
+{
+    Buffer *buffer = nullptr;
+    unsigned session = 0;
+    const char *name = nullptr;
+};
+
+// Buffers stay registered (and allocated) until exit, so a thread still
+// finishing an event while stop() writes the file never touches freed memory
+std::mutex registryMutex;
+std::vector<std::unique_ptr<Buffer>> registry;
+std::atomic<unsigned> session{0};
+std::atomic<size_t> droppedEvents{0};
+size_t eventsPerThread = kDefaultEventsPerThread;
+Clock::time_point epoch;
+unsigned nextTid = 1;
+
+thread_local ThreadState self;
+
+// The calling thread's buffer for the current session, allocated on first use
+Buffer *buffer()
+{
+    const unsigned s = session.load(std::memory_order_acquire);
+    if (self.buffer && self.session == s)
+        return self.buffer;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::unique_ptr<Buffer> b(new Buffer);
+    b->capacity = eventsPerThread;
+    b->events.reset(new Event[b->capacity]);
+    b->threadName.store(self.name, std::memory_order_relaxed);
+    b->tid = nextTid++;
+    b->session = s;
+    self.buffer = b.get();
+    self.session = s;
+    registry.push_back(std::move(b));
+    return self.buffer;
+}
+
+void record(const char *name, const char *cat, char ph)
+{
+    // Acquire pairs with start(), which set epoch before turning tracing on
+    if (!detail::active.load(std::memory_order_acquire))
+        return;
+    const int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count();
+    Buffer *b = buffer();
+    const size_t n = b->count.load(std::memory_order_relaxed);
+    if (n == b->capacity)
+    {
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    b->events[n] = Event{name, cat, ns, ph};
+    b->count.store(n + 1, std::memory_order_release);
+}
+
+void writeString(FILE *f, const char *s)
+{
+    fputc('"', f);
+    for (; s && *s; ++s)
+    {
+        const unsigned char c = static_cast<unsigned char>(*s);
+        if (c == '"' || c == '\\')
+            fprintf(f, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(f, "\\u%04x", c);
+        else
+            fputc(c, f);
+    }
+    fputc('"', f);
+}
+} // namespace
+
+void start(size_t perThread)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    eventsPerThread = perThread ? perThread : 1;
+    epoch = Clock::now();
+    droppedEvents.store(0, std::memory_order_relaxed);
+    nextTid = 1;
+    // Threads pick up fresh buffers on their next event
+    session.fetch_add(1, std::memory_order_release);
+    detail::active.store(true, std::memory_order_release);
+}
+
+bool stop(const char *path)
+{
+    detail::active.store(false, std::memory_order_release);
+
+    FILE *f = fopen(path, "w");
+    if (!f)
+        return false;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    const unsigned s = session.load(std::memory_order_relaxed);
+    bool first = true;
+    auto sep = [&]()
+    {
+        fputs(first ? "\n" : ",\n", f);
+        first = false;
+    };
+
+    fputs("{\"traceEvents\":[", f);
+    for (const auto &b : registry)
+    {
+        if (b->session != s)
+            continue;
+        if (const char *name = b->threadName.load(std::memory_order_relaxed))
+        {
+            sep();
+            fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", b->tid);
+            writeString(f, name);
+            fputs("}}", f);
+        }
+        const size_t n = b->count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < n; ++i)
+        {
+            const Event &e = b->events[i];
+            sep();
+            fputs("{\"name\":", f);
+            writeString(f, e.name);
+            fputs(",\"cat\":", f);
+            writeString(f, e.cat);
+            fprintf(f, ",\"ph\":\"%c\",\"ts\":%lld.%03lld,\"pid\":1,\"tid\":%u", e.ph,
+                    static_cast<long long>(e.ns / 1000), static_cast<long long>(e.ns % 1000), b->tid);
+            if (e.ph == 'i')
+                fputs(",\"s\":\"t\"", f);
+            fputc('}', f);
+        }
+    }
+    fputs("\n],\"displayTimeUnit\":\"ms\"}\n", f);
+    return fclose(f) == 0;
+}
+
+size_t recorded()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    const unsigned s = session.load(std::memory_order_relaxed);
+    size_t n = 0;
+    for (const auto &b : registry)
+        if (b->session == s)
+            n += b->count.load(std::memory_order_acquire);
+    return n;
+}
+
+size_t dropped() { return droppedEvents.load(std::memory_order_relaxed); }
+
+void setThreadName(const char *name)
+{
+    self.name = name;
+    if (self.buffer && self.session == session.load(std::memory_order_acquire))
+        self.buffer->threadName.store(name, std::memory_order_relaxed);
+}
+
+void begin(const char *name, const char *cat) { record(name, cat, 'B'); }
+void end(const char *name, const char *cat) { record(name, cat, 'E'); }
+void instant(const char *name, const char *cat) { record(name, cat, 'i'); }
+} // namespace Trace
@@ -0,0 +1,57 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer/single-consumer handoff of the latest value.
+//
+// Three slots rotate between the producer (back), the consumer (front) and a
+// shared middle slot. publish() swaps the filled back slot into the middle;
+// acquire() swaps the middle into the front if it holds something new. Neither
+// side ever waits for the other: a producer that outruns the consumer simply
+// replaces the unread middle value (publish() reports it as dropped), and a
+// consumer that outruns the producer keeps its current front (acquire()
+// returns false). Each side touches only its own slot, so T is copied in and
+// out without locks.
+template <typename T>
+class TripleBuffer
+{
+public:
+    // Producer: slot to fill before publish()
+    T &back() { return slots_[back_]; }
+
+    // Producer: hand the back slot to the consumer. Returns true if it replaced
+    // a value the consumer never acquired.
+    bool publish()
+    {
+        const uint8_t prev = middle_.exchange(uint8_t(back_ | kFresh), std::memory_order_acq_rel);
+        back_ = prev & kIndexMask;
+        return (prev & kFresh) != 0;
+    }
+
+    // Consumer: move the newest published value to front(); false if nothing
+    // was published since the last acquire()
+    bool acquire()
+    {
+        // Only acquire() clears kFresh, so a fresh middle stays fresh until the exchange
+        if (!(middle_.load(std::memory_order_relaxed) & kFresh))
+            return false;
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+        return true;
+    }
+
+    // Consumer: last acquired value (value-initialized before the first one)
+    const T &front() const { return slots_[front_]; }
+
+private:
+    static constexpr uint8_t kIndexMask = 0x03;
+    static constexpr uint8_t kFresh = 0x04; // middle holds an unread value
+
+    T slots_[3]{};
+    std::atomic<uint8_t> middle_{1}; // slot index | kFresh
+    uint8_t back_{0};                // producer only
+    uint8_t front_{2};               // consumer only
+};
+
+#endif // TRIPLE_BUFFER_H
@@ -0,0 +1,72 @@
+#ifndef VIRTUAL_TIMING_H
+#define VIRTUAL_TIMING_H
+
+#include "Timing.h"
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @brief Simulated clock for deterministic, faster-than-real-time runs.
+ *
+ * Nothing here reads a real clock: the driver calls step() once per
+ * App::loopOnce() and the scene clock moves by exactly 1/targetHz, and
+ * sleep() moves it by the requested time instead of blocking. A run then
+ * depends only on the seed, the input and the step count, so it is
+ * bit-identical from one run to the next and a 3-minute Maze round takes
+ * as long as the CPU needs for 10800 steps.
+ */
+class VirtualTiming final : public Timing
+{
+    const double defaultTargetHz_{60.0};
+    double targetHz_;
+    double stepMs_;
+    double nowMs_ = 0.0;   // scene clock
+    double totalMs_ = 0.0; // simulated time since construction, across scenes
+    uint64_t steps_ = 0;
+
+public:
+    explicit VirtualTiming(double targetHz)
+        : defaultTargetHz_(targetHz), targetHz_(targetHz), stepMs_(MILLIS_PER_SEC / targetHz) {}
+
+    // Advance the clock by one fixed step
+    void step()
+    {
+        nowMs_ += stepMs_;
+        totalMs_ += stepMs_;
+        ++steps_;
+    }
+
+    uint64_t steps() const { return steps_; }
+    double totalMs() const { return totalMs_; }
+
+    // Timing API
+    millis_t nowMs() const override { return static_cast<millis_t>(nowMs_); }
+    float dtMs() const override { return static_cast<float>(stepMs_); }
+    double targetHz() const override { return targetHz_; }
+
+    void setTargetHz(double hz) override
+    {
+        targetHz_ = hz;
+        stepMs_ = MILLIS_PER_SEC / targetHz_;
+    }
+
+    // When there is a preferred timing, apply it; otherwise use default
+    void applyPreference(SceneTimingPrefs pref) override
+    {
+        if (std::isnan(pref.targetHz))
+            setTargetHz(defaultTargetHz_);
+        else
+            setTargetHz(pref.targetHz);
+    }
+
+    void resetSceneClock() override { nowMs_ = 0.0; }
+
+    // Virtual time passes; the caller does not wait
+    void sleep(millis_t ms) override
+    {
+        nowMs_ += ms;
+        totalMs_ += ms;
+    }
+};
+
+#endif // VIRTUAL_TIMING_H
@@ -0,0 +1,323 @@
+// GRID asset packer: turns text-art sources into bit-packed const arrays.
+//
+// Usage: assetpack [--check] OUT_DIR SOURCE...
+//
+// Every sprite source goes into OUT_DIR/Assets.h and OUT_DIR/Assets.cpp as a
+// Sprite32 in namespace Assets; every font source becomes OUT_DIR/<name>.cpp
+// (column-major glyph bytes, the FONT5x7 layout). With --check nothing is
+// written: the exit status is 1 if any output differs from what is on disk.
+//
+// Source format, one asset per file. Lines starting with "//" are comments.
+//   sprite NAME          or   font NAME     (C++ name of the array)
+//   size W H             frame size in pixels (sprites: W <= 32; fonts: H <= 8)
+//   palette R G B        sprites: color of the next index (1..3), 0..7 each
+//   first N              fonts: character code of the first glyph (default 32)
+//   count N              fonts: declared glyph count (default: glyphs given)
+//   frame [LABEL]        starts a frame (a glyph, for fonts); the next H lines
+//                        are its rows: '.' transparent/off, '#' or '1' index 1,
+//                        '2' and '3' indices 2 and 3
+// Sprites with more than one color use two mask planes.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Asset
+{
+    enum Kind
+    {
+        Sprite,
+        Font
+    } kind{Sprite};
+    std::string source; // path, for messages and the generated comment
+    std::string name;
+    int w{0}, h{0};
+    int first{32};
+    int count{0};
+    std::vector<std::string> palette; // "{r, g, b}"
+    std::vector<std::vector<uint8_t>> frames; // w * h color indices each
+    int maxIndex{0};
+};
+
+[[noreturn]] void fail(const std::string &where, const std::string &what)
+{
+    std::fprintf(stderr, "assetpack: %s: %s\n", where.c_str(), what.c_str());
+    std::exit(2);
+}
+
+std::string stem(const std::string &path)
+{
+    const size_t slash = path.find_last_of('/');
+    std::string s = slash == std::string::npos ? path : path.substr(slash + 1);
+    const size_t dot = s.find_last_of('.');
+    return dot == std::string::npos ? s : s.substr(0, dot);
+}
+
+Asset parse(const std::string &path)
+{
+    std::ifstream in(path);
+    if (!in)
+        fail(path, "cannot open");
+    Asset a;
+    a.source = path;
+    bool named = false;
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line))
+    {
+        ++lineNo;
+        const std::string where = path + ":" + std::to_string(lineNo);
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty() || line.compare(0, 2, "//") == 0)
+            continue;
+        std::istringstream words(line);
+        std::string key;
+        words >> key;
+        if (key == "sprite" || key == "font")
+        {
+            a.kind = key == "font" ? Asset::Font : Asset::Sprite;
+            if (!(words >> a.name))
+                fail(where, "missing name");
+            named = true;
+        }
+        else if (key == "size")
+        {
+            if (!(words >> a.w >> a.h) || a.w < 1 || a.h < 1)
+                fail(where, "bad size");
+        }
+        else if (key == "palette")
+        {
+            int r, g, b;
+            if (!(words >> r >> g >> b) || r < 0 || r > 7 || g < 0 || g > 7 || b < 0 || b > 7)
+                fail(where, "palette needs three values 0..7");
+            a.palette.push_back("{" + std::to_string(r) + ", " + std::to_string(g) + ", " + std::to_string(b) + "}");
+        }
+        else if (key == "first")
+        {
+            if (!(words >> a.first))
+                fail(where, "bad first");
+        }
+        else if (key == "count")
+        {
+            if (!(words >> a.count))
+                fail(where, "bad count");
+        }
+        else if (key == "frame")
+        {
+            if (!a.w)
+                fail(where, "frame before size");
+            std::vector<uint8_t> px;
+            for (int y = 0; y < a.h; ++y)
+            {
+                if (!std::getline(in, line))
+                    fail(where, "frame ends early");
+                ++lineNo;
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                if (int(line.size()) != a.w)
+                    fail(path + ":" + std::to_string(lineNo), "row is not " + std::to_string(a.w) + " wide");
+                for (char c : line)
+                {
+                    int idx;
+                    if (c == '.')
+                        idx = 0;
+                    else if (c == '#')
+                        idx = 1;
+                    else if (c >= '1' && c <= '3')
+                        idx = c - '0';
+                    else
+                        fail(path + ":" + std::to_string(lineNo), std::string("bad pixel '") + c + "'");
+                    if (idx > a.maxIndex)
+                        a.maxIndex = idx;
+                    px.push_back(uint8_t(idx));
+                }
+            }
+            a.frames.push_back(px);
+        }
+        else
+            fail(where, "unknown directive '" + key + "'");
+    }
+    if (!named)
+        fail(path, "missing sprite/font line");
+    if (a.frames.empty())
+        fail(path, "no frames");
+    if (a.kind == Asset::Sprite)
+    {
+        if (a.w > 32 || a.frames.size() > 255 || a.h > 255)
+            fail(path, "sprites are at most 32 wide, 255 tall and 255 frames");
+        if (int(a.palette.size()) < a.maxIndex)
+            fail(path, "palette has fewer colors than the art uses");
+        if (a.palette.size() > 3)
+            fail(path, "at most three colors");
+    }
+    else
+    {
+        if (a.h > 8 || a.maxIndex > 1)
+            fail(path, "font glyphs are one color and at most 8 tall");
+        if (!a.count)
+            a.count = int(a.frames.size());
+        if (a.count < int(a.frames.size()))
+            fail(path, "count is smaller than the glyphs given");
+    }
+    return a;
+}
+
+std::string hex(unsigned v)
+{
+    char buf[8];
+    std::snprintf(buf, sizeof buf, "0x%02X", v);
+    return buf;
+}
+
+std::string generatedBy(const std::vector<Asset> &assets)
+{
+    std::string s = "// Generated by assetpack (`make assets`) from";
+    for (const Asset &a : assets)
+        s += " " + a.source;
+    return s + ".\n// Edit the sources and regenerate instead of editing this file.\n";
+}
+
+// Packed bit stream in the Sprite32 layout (rows of w bits, LSB first)
+std::vector<uint8_t> packSprite(const Asset &a, int bpp)
+{
+    std::vector<uint8_t> bytes;
+    size_t bit = 0;
+    for (const auto &px : a.frames)
+        for (int plane = 0; plane < bpp; ++plane)
+            for (int i = 0; i < a.w * a.h; ++i, ++bit)
+            {
+                if (bit % 8 == 0)
+                    bytes.push_back(0);
+                if (px[i] >> plane & 1)
+                    bytes.back() |= uint8_t(1u << (bit % 8));
+            }
+    return bytes;
+}
+
+void emitSprites(const std::vector<Asset> &sprites, std::string &header, std::string &source)
+{
+    header = "#ifndef ASSETS_H\n#define ASSETS_H\n\n" + generatedBy(sprites) +
+             "\n#include \"Sprite32.h\"\n\nnamespace Assets\n{\n";
+    source = generatedBy(sprites) + "\n#include \"Assets.h\"\n\nnamespace Assets\n{\n";
+    for (size_t n = 0; n < sprites.size(); ++n)
+    {
+        const Asset &a = sprites[n];
+        const int bpp = a.maxIndex > 1 ? 2 : 1;
+        const std::vector<uint8_t> bytes = packSprite(a, bpp);
+        const size_t unpacked = a.frames.size() * size_t(a.w * a.h);
+        header += "// " + std::to_string(a.w) + "x" + std::to_string(a.h) + ", " + std::to_string(a.frames.size()) +
+                  (a.frames.size() == 1 ? " frame" : " frames") + ", " + std::to_string(bytes.size()) +
+                  " bytes packed (" + std::to_string(unpacked) + " at a byte per pixel)\n";
+        header += "extern const Sprite32 " + a.name + ";\n";
+
+        source += (n ? "\n" : "") + std::string("static const uint8_t ") + a.name + "Bits[" +
+                  std::to_string(bytes.size()) + "] = {";
+        for (size_t i = 0; i < bytes.size(); ++i)
+            source += std::string(i % 12 ? " " : "\n    ") + hex(bytes[i]) + (i + 1 < bytes.size() ? "," : "");
+        source += "};\n";
+        source += "static const Color333 " + a.name + "Palette[" + std::to_string(a.palette.size()) + "] = {";
+        for (size_t i = 0; i < a.palette.size(); ++i)
+            source += (i ? ", " : "") + a.palette[i];
+        source += "};\n";
+        source += "const Sprite32 " + a.name + " = {" + std::to_string(a.w) + ", " + std::to_string(a.h) + ", " +
+                  std::to_string(bpp) + ", " + std::to_string(a.frames.size()) + ", " + a.name + "Bits, " + a.name +
+                  "Palette};\n";
+    }
+    header += "} // namespace Assets\n\n#endif // ASSETS_H\n";
+    source += "} // namespace Assets\n";
+}
+
+std::string charLabel(int code)
+{
+    if (code == '\'' || code == '\\')
+        return std::string("'\\") + char(code) + "'";
+    if (code >= 32 && code < 127)
+        return std::string("'") + char(code) + "'";
+    return std::to_string(code);
+}
+
+std::string emitFont(const Asset &a)
+{
+    const int lastCode = a.first + int(a.frames.size()) - 1;
+    std::string s = generatedBy({a}) + "\n#include <cstdint>\n\nusing PixelMap = uint8_t;\n\n";
+    s += "// The " + std::to_string(a.w) + "x" + std::to_string(a.h) + " pixel map for ASCII font (" +
+         (a.first == ' ' ? std::string("space") : charLabel(a.first)) + ".." + charLabel(lastCode) + ")\n";
+    s += "extern const PixelMap " + a.name + "[" + std::to_string(a.count) + "][" + std::to_string(a.w) + "] = {";
+    for (size_t g = 0; g < a.frames.size(); ++g)
+    {
+        s += "\n    /* " + charLabel(a.first + int(g)) + " */ {";
+        for (int x = 0; x < a.w; ++x)
+        {
+            unsigned col = 0; // bit y = row y
+            for (int y = 0; y < a.h; ++y)
+                col |= unsigned(a.frames[g][size_t(y * a.w + x)]) << y;
+            s += (x ? ", " : "") + hex(col);
+        }
+        s += g + 1 < a.frames.size() ? "}," : "}};\n";
+    }
+    return s;
+}
+
+// Write (or with check, compare) one output; returns true if it was up to date
+bool output(const std::string &path, const std::string &text, bool check)
+{
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream old;
+    if (in)
+        old << in.rdbuf();
+    if (in && old.str() == text)
+        return true;
+    if (check)
+    {
+        std::fprintf(stderr, "assetpack: %s is out of date\n", path.c_str());
+        return false;
+    }
+    std::ofstream out(path, std::ios::binary);
+    out << text;
+    if (!out)
+        fail(path, "cannot write");
+    std::printf("assetpack: wrote %s\n", path.c_str());
+    return false;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    bool check = false;
+    int arg = 1;
+    if (arg < argc && !std::strcmp(argv[arg], "--check"))
+    {
+        check = true;
+        ++arg;
+    }
+    if (argc - arg < 2)
+    {
+        std::fprintf(stderr, "usage: %s [--check] OUT_DIR SOURCE...\n", argv[0]);
+        return 2;
+    }
+    const std::string outDir = argv[arg++];
+    std::vector<Asset> sprites;
+    bool upToDate = true;
+    for (; arg < argc; ++arg)
+    {
+        Asset a = parse(argv[arg]);
+        if (a.kind == Asset::Font)
+            upToDate &= output(outDir + "/" + stem(a.source) + ".cpp", emitFont(a), check);
+        else
+            sprites.push_back(a);
+    }
+    if (!sprites.empty())
+    {
+        std::string header, source;
+        emitSprites(sprites, header, source);
+        upToDate &= output(outDir + "/Assets.h", header, check);
+        upToDate &= output(outDir + "/Assets.cpp", source, check);
+    }
+    return check && !upToDate ? 1 : 0;
+}
@@ -0,0 +1,236 @@
+// GRID scene benchmark: runs every scene through App, the same way the
+// emulator does, and measures what one frame costs.
+//
+// Usage: grid-bench [--scene NAME] [--frames N] [--csv FILE]
+//   NAME: start, menu, snake, life, maze, boids, calib, qr, savescore (default: all)
+//   N:    frames per scene (default 3600, one minute of scene time at 60 Hz)
+//   FILE: where the CSV goes (default grid-bench.csv; "-" for stdout)
+//
+// Each scene gets a fresh App on MemoryMatrix32 and VirtualTiming with a
+// fixed seed, and a ScriptedInputProvider that moves the stick through a
+// short loop without pressing anything, so runs are repeatable and no scene
+// is left through its menu. Per frame (one App::loopOnce()) it reports:
+//   ns/frame:      mean and p99 wall time
+//   draws/frame:   completed drawing primitives (MemoryMatrix32::drawCalls())
+//   sets/frame:    single-pixel set() writes (MemoryMatrix32::pixelSets())
+//   allocs/frame:  calls to operator new
+// A scene that switched itself away during the run (e.g. to SaveScore on game
+// over) is flagged in the table; its numbers then cover both scenes.
+#include "App.h"
+#include "EmulationLogger.h"
+#include "FileStorage.h"
+#include "MemoryMatrix32.h"
+#include "ScriptedInputProvider.h"
+#include "VirtualTiming.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+// match GRID hardware
+static constexpr double TICK_HZ = 60.0;
+static constexpr long kDefaultFrames = 3600;
+
+// Heap allocation counter: every operator new form ends up here. The bench is
+// single-threaded, so a plain counter is enough.
+static unsigned long g_allocs = 0;
+
+void *operator new(size_t n)
+{
+    ++g_allocs;
+    if (void *p = std::malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void *operator new[](size_t n) { return operator new(n); }
+void *operator new(size_t n, const std::nothrow_t &) noexcept
+{
+    ++g_allocs;
+    return std::malloc(n ? n : 1);
+}
+void *operator new[](size_t n, const std::nothrow_t &t) noexcept { return operator new(n, t); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+void operator delete[](void *p, size_t) noexcept { std::free(p); }
+
+// Discards log output: formatting still runs, the terminal I/O does not
+struct NullSink final : ILogSink
+{
+    void write(const char *, size_t, bool) override {}
+    void flush() override {}
+};
+
+using Step = ScriptedInputProvider::Step;
+
+// Stick scripts (samples, x, y, pressed); none presses the button
+static const Step kIdle[] = {{1, 0.0f, 0.0f, false}};
+// Up and down through a list
+static const Step kScroll[] = {{30, 0.0f, 1.0f, false}, {30, 0.0f, 0.0f, false},
+                               {30, 0.0f, -1.0f, false}, {30, 0.0f, 0.0f, false}};
+// Clockwise square
+static const Step kSquare[] = {{20, 1.0f, 0.0f, false}, {20, 0.0f, 1.0f, false},
+                               {20, -1.0f, 0.0f, false}, {20, 0.0f, -1.0f, false}};
+// Slow circle through the diagonals
+static const Step kCircle[] = {{15, 1.0f, 0.0f, false}, {15, 0.7f, 0.7f, false}, {15, 0.0f, 1.0f, false},
+                               {15, -0.7f, 0.7f, false}, {15, -1.0f, 0.0f, false}, {15, -0.7f, -0.7f, false},
+                               {15, 0.0f, -1.0f, false}, {15, 0.7f, -0.7f, false}};
+// Letter entry: cycle letters, move along the name
+static const Step kLetters[] = {{10, 0.0f, -1.0f, false}, {10, 0.0f, 0.0f, false},
+                                {10, 1.0f, 0.0f, false}, {10, 0.0f, 0.0f, false}};
+
+struct BenchScene
+{
+    const char *name;
+    void (*start)(App &);
+    const Step *script;
+    size_t steps;
+};
+
+#define BENCH_SCENE(name, expr, script) {name, [](App &app) { expr; }, script, sizeof(script) / sizeof(script[0])}
+
+static const BenchScene kScenes[] = {
+    BENCH_SCENE("start", app.setScene<StartScene>(), kIdle),
+    BENCH_SCENE("menu", app.setScene<MenuScene>(), kScroll),
+    BENCH_SCENE("snake", app.setScene<SnakeScene>(), kSquare),
+    BENCH_SCENE("life", app.setScene<LifeScene>(), kIdle),
+    BENCH_SCENE("maze", app.setScene<MazeScene>(), kSquare),
+    BENCH_SCENE("boids", app.setScene<BoidsScene>(), kCircle),
+    BENCH_SCENE("calib", app.setScene<CalibrationScene>(), kCircle),
+    BENCH_SCENE("qr", app.setScene<QRScene>(), kIdle),
+    BENCH_SCENE("savescore", app.setScene<SaveScoreScene>(Scene::SceneKind::Maze, "Maze", 0), kLetters),
+};
+
+struct Result
+{
+    const char *name;
+    const char *endedIn; // scene label when the run finished
+    bool switched;
+    long frames;
+    double meanNs;
+    double p99Ns;
+    double drawsPerFrame;
+    double setsPerFrame;
+    double allocsPerFrame;
+};
+
+static Result runScene(const BenchScene &bs, long frames, FileStorage &storage, std::vector<uint64_t> &ns)
+{
+    Helpers::randomSeed(1ul);
+
+    MemoryMatrix32 gfx{};
+    gfx.begin();
+    gfx.setImmediateInterval(0);
+    VirtualTiming timing{TICK_HZ};
+    NullSink sink;
+    EmulationLogger logger(timing, sink);
+    ScriptedInputProvider provider{bs.script, bs.steps};
+    Input input{};
+    input.init(&provider);
+    App app{gfx, timing, input, logger, storage};
+    bs.start(app);
+    const char *label = app.sceneLabel();
+
+    ns.clear(); // capacity reserved by the caller: no allocations in the loop
+    const uint32_t draws0 = gfx.drawCalls(), sets0 = gfx.pixelSets();
+    const unsigned long allocs0 = g_allocs;
+    for (long f = 0; f < frames; ++f)
+    {
+        timing.step();
+        const auto t0 = std::chrono::steady_clock::now();
+        app.loopOnce();
+        const auto t1 = std::chrono::steady_clock::now();
+        ns.push_back(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+    }
+    const unsigned long allocs = g_allocs - allocs0;
+    const uint32_t draws = gfx.drawCalls() - draws0, sets = gfx.pixelSets() - sets0;
+
+    Result r{};
+    r.name = bs.name;
+    r.endedIn = app.sceneLabel();
+    r.switched = std::strcmp(r.endedIn, label) != 0;
+    r.frames = frames;
+    double total = 0.0;
+    for (uint64_t v : ns)
+        total += double(v);
+    r.meanNs = total / double(frames);
+    const size_t k = std::min(ns.size() - 1, size_t(double(ns.size()) * 0.99));
+    std::nth_element(ns.begin(), ns.begin() + k, ns.end());
+    r.p99Ns = double(ns[k]);
+    r.drawsPerFrame = double(draws) / double(frames);
+    r.setsPerFrame = double(sets) / double(frames);
+    r.allocsPerFrame = double(allocs) / double(frames);
+    return r;
+}
+
+static bool writeCSV(const char *path, const std::vector<Result> &results)
+{
+    FILE *f = std::strcmp(path, "-") ? std::fopen(path, "w") : stdout;
+    if (!f)
+        return false;
+    std::fprintf(f, "scene,frames,mean_ns,p99_ns,draws_per_frame,sets_per_frame,allocs_per_frame,ended_in\n");
+    for (const Result &r : results)
+        std::fprintf(f, "%s,%ld,%.0f,%.0f,%.3f,%.3f,%.4f,%s\n", r.name, r.frames, r.meanNs, r.p99Ns,
+                     r.drawsPerFrame, r.setsPerFrame, r.allocsPerFrame, r.endedIn);
+    return f == stdout ? std::fflush(f) == 0 : std::fclose(f) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *only = nullptr;
+    long frames = kDefaultFrames;
+    const char *csvPath = "grid-bench.csv";
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--scene") && i + 1 < argc)
+            only = argv[++i];
+        else if (!std::strcmp(argv[i], "--frames") && i + 1 < argc)
+            frames = std::max(1L, std::strtol(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "--csv") && i + 1 < argc)
+            csvPath = argv[++i];
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--scene NAME] [--frames N] [--csv FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    NullSink sink;
+    VirtualTiming storageTiming{TICK_HZ};
+    EmulationLogger storageLogger(storageTiming, sink);
+    FileStorage storage;
+    storage.init("save", &storageLogger);
+
+    std::vector<uint64_t> ns;
+    ns.reserve(size_t(frames));
+    std::vector<Result> results;
+    for (const BenchScene &bs : kScenes)
+        if (!only || !std::strcmp(only, bs.name))
+            results.push_back(runScene(bs, frames, storage, ns));
+    if (results.empty())
+    {
+        std::fprintf(stderr, "Unknown scene '%s'\n", only);
+        return 2;
+    }
+
+    std::printf("%-10s %8s %10s %10s %9s %9s %10s\n", "scene", "frames", "mean ns", "p99 ns", "draws/f", "sets/f",
+                "allocs/f");
+    for (const Result &r : results)
+    {
+        std::printf("%-10s %8ld %10.0f %10.0f %9.2f %9.2f %10.4f", r.name, r.frames, r.meanNs, r.p99Ns,
+                    r.drawsPerFrame, r.setsPerFrame, r.allocsPerFrame);
+        if (r.switched)
+            std::printf("  (ended in %s)", r.endedIn);
+        std::printf("\n");
+    }
+    // With the table on stdout, "-" puts the CSV right after it
+    if (!writeCSV(csvPath, results))
+    {
+        std::fprintf(stderr, "Cannot write CSV to '%s'\n", csvPath);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,175 @@
+// Headless GRID runner: drives App against MemoryMatrix32 with no window, no
+// renderer and no SDL at all. Useful on CI boxes and servers for smoke and
+// soak runs of every scene at full CPU speed.
+//
+// Usage: grid-headless [--scene NAME] [--frames N] [--turbo] [--record FILE] [--trace FILE]
+//   NAME: start, menu, snake, life, maze, boids, calib, qr, savescore
+//   --turbo: run on VirtualTiming, a simulated clock that advances one fixed
+//            step per frame, so N frames are N/targetHz seconds of scene time
+//            however fast they run, and repeated runs are bit-identical
+//   --record FILE: .gif, .ppm or raw, as in the emulator; stamped with scene time.
+//                  Every frame is kept: the loop waits when the encoder falls behind
+//   --trace FILE: write a Chrome/Perfetto trace of the run (ui.perfetto.dev)
+// The last line reports a hash of every presented frame, to compare runs.
+#include "App.h"
+#include "EmulationLogger.h"
+#include "FileStorage.h"
+#include "FrameRecorder.h"
+#include "MemoryMatrix32.h"
+#include "NullInputProvider.h"
+#include "SteadyClockTiming.h"
+#include "Trace.h"
+#include "VirtualTiming.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+// match GRID hardware
+static constexpr double TICK_HZ = 60.0;
+static constexpr long kDefaultFrames = 600; // 10 s of scene time at 60 Hz
+
+// Start the named scene; returns false for unknown names
+static bool startScene(App &app, const char *name)
+{
+    if (!std::strcmp(name, "start"))
+        app.setScene<StartScene>();
+    else if (!std::strcmp(name, "menu"))
+        app.setScene<MenuScene>();
+    else if (!std::strcmp(name, "snake"))
+        app.setScene<SnakeScene>();
+    else if (!std::strcmp(name, "life"))
+        app.setScene<LifeScene>();
+    else if (!std::strcmp(name, "maze"))
+        app.setScene<MazeScene>();
+    else if (!std::strcmp(name, "boids"))
+        app.setScene<BoidsScene>();
+    else if (!std::strcmp(name, "calib"))
+        app.setScene<CalibrationScene>();
+    else if (!std::strcmp(name, "qr"))
+        app.setScene<QRScene>();
+    else if (!std::strcmp(name, "savescore"))
+        app.setScene<SaveScoreScene>(Scene::SceneKind::Maze, "Maze", 0);
+    else
+        return false;
+    return true;
+}
+
+// FNV-1a over a presented frame, chained from the previous frames' hash
+static uint64_t hashFrame(uint64_t h, const Color888 *fb)
+{
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(fb);
+    for (size_t i = 0; i < sizeof(Color888) * MATRIX_WIDTH * MATRIX_HEIGHT; ++i)
+        h = (h ^ p[i]) * 0x100000001b3ull;
+    return h;
+}
+
+int main(int argc, char **argv)
+{
+    const char *sceneName = "start";
+    long frames = kDefaultFrames;
+    const char *recordPath = nullptr;
+    const char *tracePath = nullptr;
+    bool turbo = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--scene") && i + 1 < argc)
+            sceneName = argv[++i];
+        else if (!std::strcmp(argv[i], "--frames") && i + 1 < argc)
+            frames = std::strtol(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--record") && i + 1 < argc)
+            recordPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--trace") && i + 1 < argc)
+            tracePath = argv[++i];
+        else if (!std::strcmp(argv[i], "--turbo"))
+            turbo = true;
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--scene NAME] [--frames N] [--turbo] [--record FILE] [--trace FILE]\n",
+                         argv[0]);
+            return 2;
+        }
+    }
+
+    Helpers::randomSeed(1ul); // fixed seed: headless runs should be repeatable
+    if (tracePath) // ~12 events a frame; room for the whole run, up to 128 MB
+        Trace::start(std::min(std::max(Trace::kDefaultEventsPerThread, size_t(frames) * 16), size_t(1) << 22));
+
+    FileStorage storage;
+    MemoryMatrix32 gfx{};
+    gfx.begin();
+    gfx.setImmediateInterval(0); // no wall-clock throttle: present counts stay repeatable
+    StdoutSink sink;
+    SteadyClockTiming wallTiming{TICK_HZ};
+    VirtualTiming virtualTiming{TICK_HZ};
+    Timing &timing = turbo ? static_cast<Timing &>(virtualTiming) : wallTiming;
+    EmulationLogger logger(timing, sink);
+    storage.init("save", &logger);
+
+    NullInputProvider inputProvider{};
+    Input input{};
+    input.init(&inputProvider);
+    App app{gfx, timing, input, logger, storage};
+
+    if (!startScene(app, sceneName))
+    {
+        logger.logf(LogLevel::Warning, "Unknown scene '%s'", sceneName);
+        return 2;
+    }
+
+    FrameRecorder recorder;
+    if (recordPath && !recorder.start(recordPath, FrameRecorder::formatFor(recordPath)))
+    {
+        logger.logf(LogLevel::Warning, "Cannot record to '%s'", recordPath);
+        return 2;
+    }
+
+    uint64_t frameHash = 0xcbf29ce484222325ull;
+    if (gfx.presents()) // presented by the scene's setup()
+        frameHash = hashFrame(frameHash, gfx.fb_);
+    const auto t0 = std::chrono::steady_clock::now();
+    for (long f = 0; f < frames; ++f)
+    {
+        const uint32_t presented = gfx.presents();
+        if (turbo)
+            virtualTiming.step();
+        app.loopOnce();
+        if (gfx.presents() == presented)
+            continue;
+        frameHash = hashFrame(frameHash, gfx.fb_);
+        // Stamp with the nominal (or virtual) frame time: the loop runs far faster than real time.
+        // No frame budget here, so wait for the encoder rather than drop frames.
+        if (recorder.recording())
+            recorder.pushWait(gfx.fb_, static_cast<millis_t>(turbo ? virtualTiming.totalMs()
+                                                               : f * Timing::MILLIS_PER_SEC / TICK_HZ));
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+
+    const double elapsedMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    if (turbo)
+        logger.logf(LogLevel::Info, "Turbo: %.1f s of scene time simulated (%.0fx real time)",
+                    virtualTiming.totalMs() / Timing::MILLIS_PER_SEC,
+                    elapsedMs > 0.0 ? virtualTiming.totalMs() / elapsedMs : 0.0);
+    logger.logf(LogLevel::Info, "Headless: %ld frames of '%s' in %.2f ms (%.0f fps), %u presents, %u static frames skipped, frame hash %016llx",
+                frames, sceneName, elapsedMs,
+                elapsedMs > 0.0 ? frames * Timing::MILLIS_PER_SEC / elapsedMs : 0.0,
+                static_cast<unsigned>(gfx.presents()), static_cast<unsigned>(gfx.skippedPresents()),
+                static_cast<unsigned long long>(frameHash));
+    if (recorder.recording())
+    {
+        recorder.stop();
+        logger.logf(LogLevel::Info, "Recorded %u frames to '%s' (%u dropped)",
+                    unsigned(recorder.written()), recordPath, unsigned(recorder.dropped()));
+    }
+    if (tracePath)
+    {
+        const size_t events = Trace::recorded(), dropped = Trace::dropped();
+        if (Trace::stop(tracePath))
+            logger.logf(LogLevel::Info, "Traced %lu events to '%s' (%lu dropped)",
+                        static_cast<unsigned long>(events), tracePath, static_cast<unsigned long>(dropped));
+        else
+            logger.logf(LogLevel::Warning, "Cannot write trace to '%s'", tracePath);
+    }
+    logger.flush();
+    return 0;
+}
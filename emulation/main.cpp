@@ -2,21 +2,66 @@
 #include "EmulationLogger.h"
 #include "FileStorage.h"
 #include "FixedStepTiming.h"
+#include "FrameRecorder.h"
 #include "IStorage.h"
 #include "SDLInputProvider.h"
 #include "SDLMatrix32.h"
 #include "StartScene.h"
+#include "Trace.h"
 #include <SDL.h>
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <chrono>
+#include <cstring>
+#include <thread>
 
 // match GRID hardware
 static constexpr double TICK_HZ = 60.0;
 
-// Main emulation loop
-void run_emulation()
+// Simulation thread: fixed-step scene updates; frames go to the render thread via gfx.show()
+static void run_simulation(App &app, SDLMatrix32 &gfx, FixedStepTiming &timing, ILogger &logger,
+                           int displayHz, const std::atomic<bool> &running)
 {
+    Trace::setThreadName("simulation");
+    millis_t log_last_ms{};
+    millis_t now_ms{};
+    FrameStats last = gfx.frameStats();
+
+    while (running.load(std::memory_order_relaxed))
+    {
+        // Catch-up bursts run every step but present only the last frame
+        int steps = timing.pump();
+        for (int i = 0; i < steps; ++i)
+            app.update(); // Scene consumes ctx.timing
+        const bool between = app.drawsBetweenSteps();
+        if (steps > 0 || between)
+            app.render(); // in between steps the scene blends by timing.alpha()
+
+        now_ms = timing.nowMs();
+        if (now_ms - log_last_ms >= timing.MILLIS_PER_SEC)
+        {
+            app.logDiagnostics();
+            const FrameStats stats = gfx.frameStats();
+            logger.logf(LogLevel::Debug, "Frames: %u published, %u presented, %u dropped, %u duplicated",
+                        unsigned(stats.published - last.published), unsigned(stats.presented - last.presented),
+                        unsigned(stats.dropped - last.dropped), unsigned(stats.duplicated - last.duplicated));
+            last = stats;
+            log_last_ms = now_ms;
+        }
+        timing.sleep_to_cadence(between ? 1.0 / displayHz : 1.0);
+    }
+}
+
+// Main emulation loop; recordPath (optional) captures presented frames, see FrameRecorder;
+// tracePath (optional) receives a Chrome/Perfetto trace of the session, see Trace.h.
+// This thread owns SDL: it pumps events and presents at display rate while
+// the scenes run on a simulation thread.
+void run_emulation(const char *recordPath, const char *tracePath)
+{
+    Trace::setThreadName("render");
+    if (tracePath)
+        Trace::start();
     unsigned long seed = static_cast<unsigned long>(
         std::chrono::high_resolution_clock::now().time_since_epoch().count());
     // unsigned long seed = 1l; // use consistent seed for emulation testing
@@ -36,9 +81,7 @@ void run_emulation()
     SDLInputProvider inputProvider{calib};
 
     SDL_Window *win = gfx.window();
-    bool running = true; // main loop flag
-    millis_t log_last_ms{};
-    millis_t now_ms{};
+    std::atomic<bool> running{true}; // main loop flag, read by both threads
 
     if (!inputProvider.init(win))
     {
@@ -60,29 +103,80 @@ void run_emulation()
     input.init(&inputProvider);
     App app{gfx, timing, input, logger, storage};
 
+    FrameRecorder recorder;
+    if (recordPath)
+    {
+        if (recorder.start(recordPath, FrameRecorder::formatFor(recordPath)))
+            gfx.setRecorder(&recorder);
+        else
+            logger.logf(LogLevel::Warning, "Cannot record to '%s'", recordPath);
+    }
+
+    app.setTransition(Transition32::Kind::Cut);
     app.setScene<StartScene>();
 
+    const int displayHz = gfx.displayHz();
+    std::thread sim(run_simulation, std::ref(app), std::ref(gfx), std::ref(timing), std::ref(logger), displayHz,
+                    std::cref(running));
+
+    // Render loop: one present per display refresh, paced on the performance counter
+    const uint64_t freq = SDL_GetPerformanceFrequency();
+    const uint64_t period = freq / uint64_t(displayHz);
+    uint64_t next = SDL_GetPerformanceCounter();
     while (running)
     {
-        int steps = timing.pump();
-        for (int i = 0; i < steps; ++i)
-        {
-            inputProvider.pumpEvents(); // handle input events
-            app.loopOnce();             // Scene consumes ctx.timing
-        }
+        inputProvider.pumpEvents(); // handle input events (may clear running)
+        gfx.present();
 
-        now_ms = timing.nowMs();
-        if (now_ms - log_last_ms >= timing.MILLIS_PER_SEC)
-        {
-            app.logDiagnostics();
-            log_last_ms = now_ms;
-        }
-        timing.sleep_to_cadence();
+        next += period;
+        const uint64_t now = SDL_GetPerformanceCounter();
+        if (next > now)
+            SDL_Delay(Uint32((next - now) * 1000 / freq));
+        else
+            next = now; // fell behind: present again right away, don't try to catch up
+    }
+    sim.join();
+
+    if (tracePath)
+    {
+        const size_t events = Trace::recorded(), dropped = Trace::dropped();
+        if (Trace::stop(tracePath))
+            logger.logf(LogLevel::Info, "Traced %lu events to '%s' (%lu dropped)",
+                        static_cast<unsigned long>(events), tracePath, static_cast<unsigned long>(dropped));
+        else
+            logger.logf(LogLevel::Warning, "Cannot write trace to '%s'", tracePath);
+        logger.flush();
+    }
+
+    if (recorder.recording())
+    {
+        gfx.setRecorder(nullptr);
+        recorder.stop();
+        logger.logf(LogLevel::Info, "Recorded %u frames to '%s' (%u dropped)",
+                    unsigned(recorder.written()), recordPath, unsigned(recorder.dropped()));
+        logger.flush();
     }
 }
 
-int main()
+// Usage: grid-emulation [--record FILE] [--trace FILE]
+//   --record FILE: .gif (animated), .ppm (numbered image sequence) or anything else (raw RGB24)
+//   --trace FILE: Chrome/Perfetto trace-event JSON (open in ui.perfetto.dev or chrome://tracing)
+int main(int argc, char **argv)
 {
-    run_emulation();
+    const char *recordPath = nullptr;
+    const char *tracePath = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--record") && i + 1 < argc)
+            recordPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--trace") && i + 1 < argc)
+            tracePath = argv[++i];
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--record FILE] [--trace FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+    run_emulation(recordPath, tracePath);
     return 0;
 }
@@ -0,0 +1,488 @@
+// GRID microbenchmarks: small, SDL-free timing loops for hot drawing paths.
+//
+// Usage: grid-microbench [--iters N] [--reps N] [--json FILE]
+//
+// color: cost of one framebuffer pixel write (Color333 conversion + store).
+//        panel565: RGBmatrixPanel's out-of-line Color333() ("before") against
+//        the 512-entry table RGBMatrix32 uses now ("after").
+//        color888: a 512-entry table ("before", tried and dropped: slower)
+//        against the per-channel curve SDLMatrix32/MemoryMatrix32 keep ("after").
+// ram:   framebuffer RAM of RGBMatrix32's direct mode against its palette-
+//        indexed modes (GRID_INDEXED_FB=8 / =4), from the real storage types.
+//        Also checks that clear() on a full 4-bit palette leaves every pixel
+//        black (not the nearest palette entry).
+// transition: one full-frame step of each Transition32 kernel into a canvas
+//        (budget: well under 1 ms per step on the host).
+// postfx: one full-frame PostFX32 pass per effect on a canvas, scalar row
+//        kernels against the SIMD ones (which must produce the same frame).
+// primitives: the Matrix32 calls scenes make every frame (fillRect, drawLine,
+//        circles, text, blitCols, ScrollText::step) plus ColorHSV333 and
+//        convertColor, on each SDL-free backend: "memory" (MemoryMatrix32,
+//        the same Color888 framebuffer path as SDLMatrix32), "canvas"
+//        (Canvas32) and "displaylist" (DisplayListMatrix32 recording into a
+//        MemoryMatrix32, flushed after every call). Each case is warmed up,
+//        then timed --reps times over --iters calls; it reports the median
+//        (and fastest) ns/op and pixels/s, where pixels/op is what one call
+//        writes on a blank canvas. --json FILE writes these results with a
+//        fixed key order and case order, so runs diff cleanly between commits.
+#include "Canvas32.h"
+#include "Color888Lut.h"
+#include "DisplayListMatrix32.h"
+#include "IndexedPixels.h"
+#include "Matrix32.h"
+#include "MemoryMatrix32.h"
+#include "PanelColor.h"
+#include "PostFX32.h"
+#include "ScrollTextHelper.h"
+#include "Transition32.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static constexpr int kPixels = MATRIX_WIDTH * MATRIX_HEIGHT;
+static constexpr long kDefaultIters = 20000; // full-frame passes per case
+static constexpr int kDefaultReps = 5;       // timed repetitions per primitive case
+
+// Alternative for SDLMatrix32/MemoryMatrix32: all 512 colors expanded at compile time
+struct Color888Table
+{
+    Color888 entries[COLOR333_COUNT]{};
+
+    constexpr Color888Table()
+    {
+        for (uint16_t i = 0; i < COLOR333_COUNT; ++i)
+            entries[i] = Color888{kExpand3to8Gamma[(i >> 6) & 0x7], kExpand3to8Gamma[(i >> 3) & 0x7], kExpand3to8Gamma[i & 0x7]};
+    }
+};
+static constexpr Color888Table kColor888Table{};
+static inline Color888 color888Table(Color333 c) { return kColor888Table.entries[packColor333(c)]; }
+
+// Before: RGBMatrix32 called RGBmatrixPanel::Color333(), an out-of-line library call
+__attribute__((noinline)) static PanelColor panelColorCall(uint8_t r, uint8_t g, uint8_t b)
+{
+    return static_cast<PanelColor>(((r & 0x7) << 13) | ((r & 0x6) << 10) | ((g & 0x7) << 8) |
+                                   ((g & 0x7) << 5) | ((b & 0x7) << 2) | ((b & 0x6) >> 1));
+}
+
+// Keep results observable so the stores are not optimized away
+static volatile uint32_t g_sink;
+
+// Run `iters` full-frame passes of writePx over a varied color pattern; returns ns per pixel
+template <class Pixel, class WritePx>
+static double timePixelWrites(const Color333 *colors, Pixel *fb, long iters, WritePx writePx)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    for (long it = 0; it < iters; ++it)
+    {
+        const int shift = int(it & 0xFF); // vary the color per pass
+        for (int i = 0; i < kPixels; ++i)
+            writePx(fb[i], colors[(i + shift) & (kPixels - 1)]);
+        g_sink = g_sink + static_cast<uint32_t>(sizeof(Pixel)) * reinterpret_cast<const uint8_t *>(fb)[it & (kPixels - 1)];
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / (double(iters) * kPixels);
+}
+
+static void report(const char *name, double beforeNs, double afterNs)
+{
+    std::printf("%-22s before %6.3f ns/px   after %6.3f ns/px   (%.2fx)\n",
+                name, beforeNs, afterNs, afterNs > 0.0 ? beforeNs / afterNs : 0.0);
+}
+
+static void benchColor(long iters)
+{
+    static_assert((kPixels & (kPixels - 1)) == 0, "pattern indexing assumes a power-of-two frame");
+
+    // Deterministic pseudo-random pattern covering the whole 9-bit space
+    static Color333 colors[kPixels];
+    uint32_t x = 2463534242u;
+    for (int i = 0; i < kPixels; ++i)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        colors[i] = Color333{uint8_t(x & 7), uint8_t((x >> 3) & 7), uint8_t((x >> 6) & 7)};
+    }
+
+    // Sanity: tables must agree with the code they replace
+    for (uint16_t i = 0; i < COLOR333_COUNT; ++i)
+    {
+        const Color333 c{uint8_t(i >> 6), uint8_t((i >> 3) & 7), uint8_t(i & 7)};
+        const Color888 a = color888Table(c), b = toColor888(c);
+        if (a.r != b.r || a.g != b.g || a.b != b.b || panelColorCall(c.r, c.g, c.b) != toPanelColor(c))
+        {
+            std::fprintf(stderr, "color LUT mismatch at %u\n", unsigned(i));
+            std::exit(1);
+        }
+    }
+
+    static Color888 fb888[kPixels];
+    static PanelColor fbPanel[kPixels];
+    const double sdlBefore = timePixelWrites(colors, fb888, iters, [](Color888 &px, Color333 c)
+                                             { px = color888Table(c); });
+    const double sdlAfter = timePixelWrites(colors, fb888, iters, [](Color888 &px, Color333 c)
+                                            { px = toColor888(c); });
+    const double panelBefore = timePixelWrites(colors, fbPanel, iters, [](PanelColor &px, Color333 c)
+                                               { px = panelColorCall(c.r, c.g, c.b); });
+    const double panelAfter = timePixelWrites(colors, fbPanel, iters, [](PanelColor &px, Color333 c)
+                                              { px = toPanelColor(c); });
+    report("color888 (SDL/memory)", sdlBefore, sdlAfter);
+    report("panel565 (RGB panel)", panelBefore, panelAfter);
+}
+
+// RGBMatrix32's GRID_INDEXED_FB storage hooks on an SDL-free, panel-free backend
+template <int Bits>
+class IndexedCanvas final : public RasterMatrix32<IndexedCanvas<Bits>>
+{
+public:
+    using Pixels = IndexedPixels<Bits>;
+    Pixels fb_;
+
+    uint16_t codeAt(int i) const { return fb_.codeAt(i); }
+    typename Pixels::Index convertColor(Color333 c) { return fb_.indexOf(c); }
+    void setPalette(const Color333 *colors, int n) { fb_.setPalette(colors, n); }
+    void storePixel(int i, typename Pixels::Index px) { fb_.store(i, px); }
+    void fillPixels(int i, int n, typename Pixels::Index px) { fb_.fill(i, n, px); }
+    void fillFrame(Color333 c) { fb_.fillFrame(c); }
+
+    void begin() override { this->clear(); }
+    void set(int x, int y, Color333 c) override
+    {
+        this->writePixel(x, y, c);
+        this->markRowDirty(y);
+    }
+    void show() override { this->dirtyRows_ = 0; }
+    millis_t wallMs() const { return 0; }
+};
+
+// Fill the palette with non-black colors, then clear: every pixel must read
+// back black, not the palette entry nearest to it
+static void checkIndexedClear()
+{
+    static IndexedCanvas<4> fb;
+    static constexpr int n = IndexedPixels<4>::kColors;
+    Color333 colors[n];
+    for (int i = 0; i < n; ++i)
+        colors[i] = Color333{uint8_t(1 + i % 7), uint8_t(1 + i / 7), uint8_t(i & 1)};
+    fb.begin();
+    fb.setPalette(colors, n); // black is no longer in the palette
+    for (int i = 0; i < n; ++i)
+        fb.drawPixel(i, 0, colors[i]);
+    fb.clear();
+    for (int i = 0; i < kPixels; ++i)
+        if (fb.codeAt(i) != 0)
+        {
+            std::fprintf(stderr, "indexed clear: pixel %d reads %03o, not black\n", i, unsigned(fb.codeAt(i)));
+            std::exit(1);
+        }
+}
+
+static void benchRam()
+{
+    checkIndexedClear();
+    const unsigned direct = unsigned(sizeof(PanelColor) * kPixels);
+    const unsigned indexed8 = unsigned(sizeof(IndexedPixels<8>));
+    const unsigned indexed4 = unsigned(sizeof(IndexedPixels<4>));
+    std::printf("%-22s %5u bytes\n", "fb direct (PanelColor)", direct);
+    std::printf("%-22s %5u bytes   (saves %u)\n", "fb indexed 8-bit", indexed8, direct - indexed8);
+    std::printf("%-22s %5u bytes   (saves %u)\n", "fb indexed 4-bit", indexed4, direct - indexed4);
+}
+
+static void benchTransition(long iters)
+{
+    static Transition32 transition;
+    static Canvas32 out;
+    // Two different full frames to mix
+    for (int i = 0; i < kPixels; ++i)
+    {
+        transition.from().fb_[i] = uint16_t((i * 37) & (COLOR333_COUNT - 1));
+        transition.to().fb_[i] = uint16_t((i * 11 + 200) & (COLOR333_COUNT - 1));
+    }
+    const struct
+    {
+        const char *name;
+        Transition32::Kind kind;
+    } cases[] = {{"transition blend", Transition32::Kind::Blend},
+                 {"transition wipe", Transition32::Kind::Wipe},
+                 {"transition slide", Transition32::Kind::Slide}};
+    const long steps = std::max(1L, iters / 10);
+    for (const auto &c : cases)
+    {
+        transition.start(c.kind, 0, 0);
+        const auto t0 = std::chrono::steady_clock::now();
+        for (long it = 0; it < steps; ++it)
+        {
+            transition.compose(out, uint16_t(it % (Transition32::kOne + 1)));
+            g_sink = g_sink + out.fb_[it & (kPixels - 1)];
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        std::printf("%-22s %8.2f us/step\n", c.name,
+                    std::chrono::duration<double, std::micro>(t1 - t0).count() / double(steps));
+    }
+}
+
+static void benchPostFX(long iters)
+{
+    static uint16_t pattern[kPixels];
+    static Canvas32 canvas, reference;
+    // Sparse bright dots over a dim background, like a Boids or Snake frame
+    for (int i = 0; i < kPixels; ++i)
+        pattern[i] = uint16_t(i % 7 == 0 ? (i * 37) & (COLOR333_COUNT - 1) : (i * 11) & 0111);
+
+    PostFX32 decay, blur, glow;
+    decay.decayKeep = 160;
+    blur.blur = true;
+    glow.glowThreshold = 5;
+    glow.glowGain = 384;
+    const struct
+    {
+        const char *name;
+        const PostFX32 *fx;
+    } cases[] = {{"postfx decay", &decay}, {"postfx blur", &blur}, {"postfx glow", &glow}};
+    const auto run = [](const PostFX32 &fx, Canvas32 &c, PostFX32::Path path)
+    {
+        if (fx.decays())
+            fx.decay(c, path);
+        fx.filter(c, path);
+    };
+
+    const long passes = std::max(1L, iters / 10);
+    for (const auto &c : cases)
+    {
+        // Sanity: both paths must write the same frame
+        std::memcpy(canvas.fb_, pattern, sizeof pattern);
+        std::memcpy(reference.fb_, pattern, sizeof pattern);
+        run(*c.fx, reference, PostFX32::Path::Scalar);
+        run(*c.fx, canvas, PostFX32::Path::Simd);
+        if (std::memcmp(canvas.fb_, reference.fb_, sizeof pattern))
+        {
+            std::fprintf(stderr, "%s: SIMD and scalar paths disagree\n", c.name);
+            std::exit(1);
+        }
+
+        double us[2];
+        const PostFX32::Path paths[2] = {PostFX32::Path::Scalar, PostFX32::Path::Simd};
+        for (int p = 0; p < 2; ++p)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            for (long it = 0; it < passes; ++it)
+            {
+                std::memcpy(canvas.fb_, pattern, sizeof pattern); // the effect runs on a fresh frame each pass
+                run(*c.fx, canvas, paths[p]);
+                g_sink = g_sink + canvas.fb_[it & (kPixels - 1)];
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            us[p] = std::chrono::duration<double, std::micro>(t1 - t0).count() / double(passes);
+        }
+        std::printf("%-22s scalar %6.2f us/frame   simd %6.2f us/frame   (%.2fx)\n",
+                    c.name, us[0], us[1], us[1] > 0.0 ? us[0] / us[1] : 0.0);
+    }
+}
+
+// One primitives case, as written to --json
+struct PrimitiveResult
+{
+    std::string name;
+    const char *backend;
+    double pixelsPerOp;
+    double nsPerOp;    // median over the repetitions
+    double nsPerOpMin; // fastest repetition
+};
+static std::vector<PrimitiveResult> g_primitives;
+
+// Pixels one call of op writes: run it once on a canvas filled with a color
+// no case draws, then count what changed
+template <class Op>
+static int pixelsWritten(Op op)
+{
+    static Canvas32 probe;
+    const uint16_t sentinel = packColor333(Color333{1, 2, 3});
+    std::fill(probe.fb_, probe.fb_ + kPixels, sentinel);
+    op(probe, 0L);
+    return int(std::count_if(probe.fb_, probe.fb_ + kPixels, [&](uint16_t px)
+                             { return px != sentinel; }));
+}
+
+// Warm up, then time `reps` runs of `iters` calls of op(gfx, i) followed by done(gfx)
+template <class M, class Op, class Done>
+static void timePrimitive(const char *name, const char *backend, M &gfx, Done done, long iters, int reps,
+                          double pixelsPerOp, Op op)
+{
+    for (long i = 0; i < std::max(1L, iters / 10); ++i)
+    {
+        op(gfx, i);
+        done(gfx);
+    }
+    std::vector<double> ns;
+    for (int r = 0; r < reps; ++r)
+    {
+        const auto t0 = std::chrono::steady_clock::now();
+        for (long i = 0; i < iters; ++i)
+        {
+            op(gfx, i);
+            done(gfx);
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        ns.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count() / double(iters));
+    }
+    std::sort(ns.begin(), ns.end());
+    const double median = ns[ns.size() / 2];
+    g_primitives.push_back(PrimitiveResult{name, backend, pixelsPerOp, median, ns.front()});
+    std::printf("%-22s %-11s %9.1f ns/op (min %9.1f) %9.1f Mpx/s\n", name, backend, median, ns.front(),
+                median > 0.0 ? pixelsPerOp * 1e3 / median : 0.0);
+}
+
+// Colors the drawing cases cycle through (never the pixelsWritten() sentinel)
+static inline Color333 caseColor(long i)
+{
+    static const Color333 colors[8] = {{7, 0, 0}, {0, 7, 0}, {0, 0, 7}, {7, 7, 0},
+                                       {0, 7, 7}, {7, 0, 7}, {7, 7, 7}, {3, 5, 1}};
+    return colors[i & 7];
+}
+
+// Every drawing case on one backend; done(gfx) runs after each call
+template <class M, class Done>
+static void benchPrimitivesOn(const char *backend, M &gfx, Done done, long iters, int reps)
+{
+    static std::vector<PixelMap> banner;
+    if (banner.empty())
+        gfx.buildStringCols("GRID ARCADE", banner);
+    ScrollText scroll;
+    scroll.prepare(gfx, "GRID ARCADE", 1, Colors::Bright::White, Colors::Black, true, true);
+
+    const auto fillRect = [](auto &m, long i)
+    { m.fillRect(4, 4, 24, 24, caseColor(i)); };
+    const auto drawLine = [](auto &m, long i)
+    { m.drawLine(0, 3, MATRIX_WIDTH - 1, 28, caseColor(i)); };
+    const auto drawCircle = [](auto &m, long i)
+    { m.drawCircle(16, 16, 12, caseColor(i)); };
+    const auto fillCircle = [](auto &m, long i)
+    { m.fillCircle(16, 16, 12, caseColor(i)); };
+    const auto drawChar = [](auto &m, long i)
+    { m.drawChar(13, 12, char('A' + (i % 26)), caseColor(i)); };
+    const auto print = [](auto &m, long i)
+    {
+        m.setTextSize(1);
+        m.setTextColor(caseColor(i));
+        m.setCursor(1, 12);
+        m.print("HI 123");
+    };
+    const auto blitCols = [](auto &m, long i)
+    { m.blitCols(0, 12, banner.data(), std::min<int>(int(banner.size()), MATRIX_WIDTH), caseColor(i), 1); };
+    const auto scrollStep = [&scroll](auto &m, long)
+    {
+        if (scroll.x > 0 || scroll.rightEdge() <= 0)
+            scroll.reset(0, ScrollText::yTopCentered(scroll.ts));
+        scroll.step(m, -1);
+    };
+
+    timePrimitive("fillRect 24x24", backend, gfx, done, iters, reps, pixelsWritten(fillRect), fillRect);
+    timePrimitive("drawLine", backend, gfx, done, iters, reps, pixelsWritten(drawLine), drawLine);
+    timePrimitive("drawCircle r12", backend, gfx, done, iters, reps, pixelsWritten(drawCircle), drawCircle);
+    timePrimitive("fillCircle r12", backend, gfx, done, iters, reps, pixelsWritten(fillCircle), fillCircle);
+    timePrimitive("drawChar", backend, gfx, done, iters, reps, pixelsWritten(drawChar), drawChar);
+    timePrimitive("print 6 chars", backend, gfx, done, iters, reps, pixelsWritten(print), print);
+    timePrimitive("blitCols 32 cols", backend, gfx, done, iters, reps, pixelsWritten(blitCols), blitCols);
+    ScrollText probe = scroll; // measured on a copy, from the position the timed runs start at
+    const auto probeStep = [&probe](auto &m, long)
+    {
+        probe.reset(0, ScrollText::yTopCentered(probe.ts));
+        probe.step(m, -1);
+    };
+    const double scrollPx = pixelsWritten(probeStep);
+    timePrimitive("ScrollText::step", backend, gfx, done, iters, reps, scrollPx, scrollStep);
+}
+
+// Color conversion cases: pixels/op is one conversion
+template <class M>
+static void benchConvertColor(const char *backend, M &gfx, long iters, int reps)
+{
+    const auto convert = [](auto &m, long i)
+    {
+        const Color333 c{uint8_t(i & 7), uint8_t((i >> 3) & 7), uint8_t((i >> 6) & 7)};
+        const auto px = m.convertColor(c);
+        g_sink = g_sink + reinterpret_cast<const uint8_t *>(&px)[0];
+    };
+    timePrimitive("convertColor", backend, gfx, [](M &) {}, iters * 10, reps, 1.0, convert);
+}
+
+static void benchPrimitives(long iters, int reps)
+{
+    static MemoryMatrix32 memory;
+    static Canvas32 canvas;
+    static MemoryMatrix32 listTarget;
+    static DisplayListMatrix32 list(listTarget);
+    memory.begin();
+    listTarget.begin();
+
+    const auto nothing = [](auto &) {};
+    benchPrimitivesOn("memory", memory, nothing, iters, reps);
+    benchPrimitivesOn("canvas", canvas, nothing, iters, reps);
+    benchPrimitivesOn("displaylist", list, [](DisplayListMatrix32 &m)
+                      { m.flush(); }, iters, reps);
+
+    const auto hsv = [](Canvas32 &, long i)
+    {
+        const Color333 c = ColorHSV333(uint16_t(i * 7), uint8_t(255 - (i & 63)), uint8_t(128 + (i & 127)));
+        g_sink = g_sink + packColor333(c);
+    };
+    timePrimitive("ColorHSV333", "-", canvas, nothing, iters * 10, reps, 1.0, hsv);
+    benchConvertColor("memory", memory, iters, reps);
+    benchConvertColor("canvas", canvas, iters, reps);
+}
+
+// Machine-readable primitives results; numbers use fixed formats so diffs stay line-per-case
+static bool writeJson(const char *path, long iters, int reps)
+{
+    FILE *f = std::fopen(path, "w");
+    if (!f)
+        return false;
+    std::fprintf(f, "{\n  \"schema\": 1,\n  \"panel\": \"%dx%d\",\n  \"iters\": %ld,\n  \"reps\": %d,\n  \"primitives\": [",
+                 MATRIX_WIDTH, MATRIX_HEIGHT, iters, reps);
+    for (size_t i = 0; i < g_primitives.size(); ++i)
+    {
+        const PrimitiveResult &r = g_primitives[i];
+        std::fprintf(f, "%s\n    {\"name\": \"%s\", \"backend\": \"%s\", \"pixels_per_op\": %.0f, "
+                        "\"ns_per_op\": %.2f, \"ns_per_op_min\": %.2f, \"pixels_per_s\": %.0f}",
+                     i ? "," : "", r.name.c_str(), r.backend, r.pixelsPerOp, r.nsPerOp, r.nsPerOpMin,
+                     r.nsPerOp > 0.0 ? r.pixelsPerOp * 1e9 / r.nsPerOp : 0.0);
+    }
+    std::fprintf(f, "\n  ]\n}\n");
+    return std::fclose(f) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    long iters = kDefaultIters;
+    int reps = kDefaultReps;
+    const char *jsonPath = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--iters") && i + 1 < argc)
+            iters = std::max(1L, std::strtol(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "--reps") && i + 1 < argc)
+            reps = int(std::max(1L, std::strtol(argv[++i], nullptr, 10)));
+        else if (!std::strcmp(argv[i], "--json") && i + 1 < argc)
+            jsonPath = argv[++i];
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--iters N] [--reps N] [--json FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+    benchColor(iters);
+    benchRam();
+    benchTransition(iters);
+    benchPostFX(iters);
+    benchPrimitives(iters, reps);
+    if (jsonPath && !writeJson(jsonPath, iters, reps))
+    {
+        std::fprintf(stderr, "Cannot write JSON to '%s'\n", jsonPath);
+        return 1;
+    }
+    return 0;
+}